@@ -0,0 +1,109 @@
+#include "animation.h"
+#include <math.h>
+#include <string.h>
+
+// sin(t * pi / 2) échantillonné sur [0, 1], EASING_STEPS + 1 points
+static float easing[EASING_STEPS + 1];
+
+static float ease(float t) {
+    if (t <= 0.0f) return 0.0f;
+    if (t >= 1.0f) return 1.0f;
+    float position = t * EASING_STEPS;
+    int i = (int)position;
+    float fraction = position - i;
+    return easing[i] + (easing[i + 1] - easing[i]) * fraction;
+}
+
+void animInit(AnimationPool *pool) {
+    for (int i = 0; i <= EASING_STEPS; i++) {
+        easing[i] = (float)sin((double)i / EASING_STEPS * M_PI / 2);
+    }
+    animClear(pool);
+}
+
+void animClear(AnimationPool *pool) {
+    pool->count = 0;
+    memset(pool->slot, NO_ANIMATION, sizeof(pool->slot));
+}
+
+// Libère l'animation id en y recopiant la dernière
+static void removeAnimation(AnimationPool *pool, int id) {
+    pool->slot[pool->pile[id]][pool->rank[id]] = NO_ANIMATION;
+    int last = --pool->count;
+    if (id == last) return;
+
+    pool->fromX[id] = pool->fromX[last];
+    pool->fromY[id] = pool->fromY[last];
+    pool->toX[id] = pool->toX[last];
+    pool->toY[id] = pool->toY[last];
+    pool->progress[id] = pool->progress[last];
+    pool->previousProgress[id] = pool->previousProgress[last];
+    pool->speed[id] = pool->speed[last];
+    pool->color[id] = pool->color[last];
+    pool->pile[id] = pool->pile[last];
+    pool->rank[id] = pool->rank[last];
+    pool->slot[pool->pile[id]][pool->rank[id]] = (int8_t)id;
+}
+
+// La plus avancée est la plus proche de sa fin
+static int mostAdvanced(const AnimationPool *pool) {
+    int best = 0;
+    for (int i = 1; i < pool->count; i++) {
+        if (pool->progress[i] > pool->progress[best]) best = i;
+    }
+    return best;
+}
+
+int animMove(AnimationPool *pool, int fromPile, int fromRank, float fromX, float fromY,
+             int toPile, int toRank, float toX, float toY, int color, float durationMs) {
+    int previous = pool->slot[fromPile][fromRank];
+    if (previous != NO_ANIMATION) {
+        animPosition(pool, previous, 1.0f, &fromX, &fromY);
+        removeAnimation(pool, previous);
+    }
+    if (pool->slot[toPile][toRank] != NO_ANIMATION) {
+        removeAnimation(pool, pool->slot[toPile][toRank]);
+    }
+    if (pool->count == MAX_ANIMATIONS) {
+        removeAnimation(pool, mostAdvanced(pool));
+    }
+
+    int id = pool->count++;
+    pool->fromX[id] = fromX;
+    pool->fromY[id] = fromY;
+    pool->toX[id] = toX;
+    pool->toY[id] = toY;
+    pool->progress[id] = 0.0f;
+    pool->previousProgress[id] = 0.0f;
+    pool->speed[id] = durationMs > 0.0f ? 1.0f / durationMs : 1.0f;
+    pool->color[id] = (uint8_t)color;
+    pool->pile[id] = (uint8_t)toPile;
+    pool->rank[id] = (uint8_t)toRank;
+    pool->slot[toPile][toRank] = (int8_t)id;
+    return id;
+}
+
+void animHurry(AnimationPool *pool, float remainingMs) {
+    for (int i = 0; i < pool->count; i++) {
+        float speed = (1.0f - pool->progress[i]) / remainingMs;
+        if (speed > pool->speed[i]) pool->speed[i] = speed;
+    }
+}
+
+void animStep(AnimationPool *pool, float stepMs) {
+    for (int i = 0; i < pool->count; i++) {
+        pool->previousProgress[i] = pool->progress[i];
+        pool->progress[i] += pool->speed[i] * stepMs;
+    }
+    // Parcours à rebours : la case libérée reçoit une animation déjà avancée
+    for (int i = pool->count - 1; i >= 0; i--) {
+        if (pool->progress[i] >= 1.0f) removeAnimation(pool, i);
+    }
+}
+
+void animPosition(const AnimationPool *pool, int id, float alpha, float *x, float *y) {
+    float t = pool->previousProgress[id] + (pool->progress[id] - pool->previousProgress[id]) * alpha;
+    float eased = ease(t);
+    *x = pool->fromX[id] + (pool->toX[id] - pool->fromX[id]) * eased;
+    *y = pool->fromY[id] + (pool->toY[id] - pool->fromY[id]) * eased;
+}
@@ -0,0 +1,61 @@
+#ifndef ANIMATION_H
+#define ANIMATION_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "game.h"
+
+// Animations de jetons, sans SDL : un pool de taille fixe rangé en tableaux par champ
+// (les pas de simulation ne parcourent que progress/previousProgress/speed). Les animations
+// actives occupent [0, count) ; une fin d'animation déplace la dernière dans la case libérée.
+// Un jeton est relié à son animation par sa case logique (pile, rang) et non par sa position
+// à l'écran : slot[pile][rang] donne l'identifiant (indice) de l'animation qui l'amène.
+#define MAX_ANIMATIONS 64
+#define NO_ANIMATION -1
+#define EASING_STEPS 256
+
+typedef struct {
+    int count;
+
+    float fromX[MAX_ANIMATIONS];
+    float fromY[MAX_ANIMATIONS];
+    float toX[MAX_ANIMATIONS];
+    float toY[MAX_ANIMATIONS];
+    float progress[MAX_ANIMATIONS];
+    float previousProgress[MAX_ANIMATIONS];
+    float speed[MAX_ANIMATIONS];        // Progression par milliseconde
+    uint8_t color[MAX_ANIMATIONS];
+    uint8_t pile[MAX_ANIMATIONS];       // Case d'arrivée du jeton
+    uint8_t rank[MAX_ANIMATIONS];
+
+    int8_t slot[MAX_PILES][MAX_TOKENS];
+} AnimationPool;
+
+void animInit(AnimationPool *pool);     // Remplit aussi la table d'amortissement
+void animClear(AnimationPool *pool);
+
+static inline bool animActive(const AnimationPool *pool) {
+    return pool->count > 0;
+}
+
+static inline int animForToken(const AnimationPool *pool, int pile, int rank) {
+    return pool->slot[pile][rank];
+}
+
+// Le jeton de la case (fromPile, fromRank), dessiné en (fromX, fromY), part vers la case
+// (toPile, toRank) en (toX, toY) en durationMs. S'il était encore en route, l'animation
+// repart de sa position affichée (coups enchaînés). Si le pool est plein, la plus avancée
+// (la plus proche de son arrivée) est terminée d'office. Retourne l'identifiant de l'animation.
+int animMove(AnimationPool *pool, int fromPile, int fromRank, float fromX, float fromY,
+             int toPile, int toRank, float toX, float toY, int color, float durationMs);
+
+// Accélère les animations en cours pour qu'elles finissent dans au plus remainingMs
+void animHurry(AnimationPool *pool, float remainingMs);
+
+// Avance toutes les animations de stepMs et libère celles qui sont terminées
+void animStep(AnimationPool *pool, float stepMs);
+
+// Position affichée, interpolée entre les deux derniers pas (alpha dans [0, 1])
+void animPosition(const AnimationPool *pool, int id, float alpha, float *x, float *y);
+
+#endif
@@ -0,0 +1,105 @@
+#include "batch.h"
+#include <stdlib.h>
+#include <string.h>
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+#define HAVE_RENDER_GEOMETRY 1
+#else
+#define HAVE_RENDER_GEOMETRY 0
+#endif
+
+void batchBegin(SpriteBatch *batch, SDL_Texture *atlas) {
+    batch->atlas = atlas;
+    batch->numQuads = 0;
+    batch->tint = (SDL_Color){255, 255, 255, 255};
+    SDL_QueryTexture(atlas, NULL, NULL, &batch->atlasWidth, &batch->atlasHeight);
+}
+
+void batchTint(SpriteBatch *batch, SDL_Color tint) {
+    batch->tint = tint;
+}
+
+bool batchQuad(SpriteBatch *batch, const SDL_Rect *src, const SDL_Rect *dst) {
+    if (batch->numQuads == batch->capQuads) {
+        int cap = batch->capQuads ? batch->capQuads * 2 : 128;
+        SDL_Rect *srcRects = realloc(batch->src, cap * sizeof(SDL_Rect));
+        if (!srcRects) return false;
+        batch->src = srcRects;
+        SDL_Rect *dstRects = realloc(batch->dst, cap * sizeof(SDL_Rect));
+        if (!dstRects) return false;
+        batch->dst = dstRects;
+        batch->capQuads = cap;
+    }
+    batch->src[batch->numQuads] = *src;
+    batch->dst[batch->numQuads] = *dst;
+    batch->numQuads++;
+    return true;
+}
+
+#if HAVE_RENDER_GEOMETRY
+// Deux triangles par quadrilatère ; les indices ne dépendent que du nombre de quadrilatères
+static bool reserveVertices(SpriteBatch *batch) {
+    if (batch->capVertices >= batch->capQuads * 4) return true;
+    int cap = batch->capQuads * 4;
+    SDL_Vertex *vertices = realloc(batch->vertices, cap * sizeof(SDL_Vertex));
+    if (!vertices) return false;
+    batch->vertices = vertices;
+    int *indices = realloc(batch->indices, cap / 4 * 6 * sizeof(int));
+    if (!indices) return false;
+    batch->indices = indices;
+    for (int q = batch->capVertices / 4; q < cap / 4; q++) {
+        static const int corners[6] = {0, 1, 2, 2, 1, 3};
+        for (int k = 0; k < 6; k++) {
+            indices[q * 6 + k] = q * 4 + corners[k];
+        }
+    }
+    batch->capVertices = cap;
+    return true;
+}
+#endif
+
+void batchFlush(SpriteBatch *batch, SDL_Renderer *renderer) {
+    if (batch->numQuads == 0) return;
+
+#if HAVE_RENDER_GEOMETRY
+    if (reserveVertices(batch)) {
+        float invW = 1.0f / batch->atlasWidth;
+        float invH = 1.0f / batch->atlasHeight;
+        for (int q = 0; q < batch->numQuads; q++) {
+            const SDL_Rect *s = &batch->src[q];
+            const SDL_Rect *d = &batch->dst[q];
+            SDL_Vertex *v = &batch->vertices[q * 4];
+            for (int k = 0; k < 4; k++) {
+                int right = k & 1, bottom = k >> 1;
+                v[k].position.x = (float)(d->x + right * d->w);
+                v[k].position.y = (float)(d->y + bottom * d->h);
+                v[k].color = batch->tint;
+                v[k].tex_coord.x = (s->x + right * s->w) * invW;
+                v[k].tex_coord.y = (s->y + bottom * s->h) * invH;
+            }
+        }
+        SDL_RenderGeometry(renderer, batch->atlas, batch->vertices, batch->numQuads * 4,
+                           batch->indices, batch->numQuads * 6);
+        batch->numQuads = 0;
+        return;
+    }
+#endif
+
+    // SDL_RenderCopy n'a pas de couleur par sommet : la teinte passe par la texture
+    SDL_SetTextureColorMod(batch->atlas, batch->tint.r, batch->tint.g, batch->tint.b);
+    SDL_SetTextureAlphaMod(batch->atlas, batch->tint.a);
+    for (int q = 0; q < batch->numQuads; q++) {
+        SDL_RenderCopy(renderer, batch->atlas, &batch->src[q], &batch->dst[q]);
+    }
+    SDL_SetTextureColorMod(batch->atlas, 255, 255, 255);
+    SDL_SetTextureAlphaMod(batch->atlas, 255);
+    batch->numQuads = 0;
+}
+
+void batchFree(SpriteBatch *batch) {
+    free(batch->src);
+    free(batch->dst);
+    free(batch->vertices);
+    free(batch->indices);
+    memset(batch, 0, sizeof(*batch));
+}
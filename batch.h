@@ -0,0 +1,37 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+
+// Lot de quadrilatères texturés issus d'un même atlas, envoyés en un seul appel
+// SDL_RenderGeometry (SDL >= 2.0.18) ; sinon un SDL_RenderCopy par quadrilatère.
+// Les tampons sont conservés d'une image à l'autre : aucune allocation en régime établi.
+typedef struct {
+    SDL_Texture *atlas;
+    int atlasWidth;
+    int atlasHeight;
+    SDL_Color tint;         // Couleur multipliée à celle de l'atlas (blanc par défaut)
+    SDL_Rect *src;
+    SDL_Rect *dst;
+    int numQuads;
+    int capQuads;
+    SDL_Vertex *vertices;
+    int *indices;
+    int capVertices;
+} SpriteBatch;
+
+void batchBegin(SpriteBatch *batch, SDL_Texture *atlas);
+
+// Teinte de tout le lot, jusqu'au prochain batchBegin (texte dessiné depuis un atlas blanc)
+void batchTint(SpriteBatch *batch, SDL_Color tint);
+
+// Ajoute la région src de l'atlas, dessinée en dst (ordre d'ajout = ordre de dessin)
+bool batchQuad(SpriteBatch *batch, const SDL_Rect *src, const SDL_Rect *dst);
+
+// Dessine le lot et le vide
+void batchFlush(SpriteBatch *batch, SDL_Renderer *renderer);
+
+void batchFree(SpriteBatch *batch);
+
+#endif
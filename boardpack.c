@@ -0,0 +1,208 @@
+#include "boardpack.h"
+#include <string.h>
+
+bool packShapeInit(PackShape *shape, const GameState *game) {
+    int bits = game->numPiles * game->maxTokens * PACK_BITS_PER_TOKEN;
+    shape->numPiles = game->numPiles;
+    shape->maxTokens = game->maxTokens;
+    shape->numColors = game->numColors;
+    shape->words = (bits + 63) / 64;
+    return game->numColors <= PACK_MAX_COLORS && game->numPiles <= PACK_MAX_PILES &&
+           game->maxTokens <= PACK_MAX_TOKENS && shape->words <= PACK_MAX_WORDS;
+}
+
+void packFromGame(const PackShape *shape, const GameState *game, PileCode *codes) {
+    for (int p = 0; p < shape->numPiles; p++) {
+        PileCode code = 0;
+        for (int t = 0; t < game->piles[p].count; t++) {
+            code |= (PileCode)(game->piles[p].colors[t] + 1) << (t * PACK_BITS_PER_TOKEN);
+        }
+        codes[p] = code;
+    }
+}
+
+void packToGame(const PackShape *shape, const PileCode *codes, GameState *game) {
+    for (int p = 0; p < shape->numPiles; p++) {
+        int count = pileCount(codes[p]);
+        game->piles[p].count = count;
+        for (int t = 0; t < count; t++) {
+            game->piles[p].colors[t] = pileCell(codes[p], t) - 1;
+        }
+    }
+    gameInitInvariants(game);
+}
+
+void packBoard(const PackShape *shape, const PileCode *codes, uint64_t *words) {
+    int pileBits = shape->maxTokens * PACK_BITS_PER_TOKEN;
+    memset(words, 0, shape->words * sizeof(uint64_t));
+
+    // Les piles sont concaténées et peuvent chevaucher deux mots
+    int bit = 0;
+    for (int p = 0; p < shape->numPiles; p++) {
+        uint64_t value = codes[p];
+        int w = bit >> 6;
+        int offset = bit & 63;
+        words[w] |= value << offset;
+        if (offset + pileBits > 64) {
+            words[w + 1] |= value >> (64 - offset);
+        }
+        bit += pileBits;
+    }
+}
+
+void unpackBoard(const PackShape *shape, const uint64_t *words, PileCode *codes) {
+    int pileBits = shape->maxTokens * PACK_BITS_PER_TOKEN;
+    uint64_t mask = (1ull << pileBits) - 1;
+
+    int bit = 0;
+    for (int p = 0; p < shape->numPiles; p++) {
+        int w = bit >> 6;
+        int offset = bit & 63;
+        uint64_t value = words[w] >> offset;
+        if (offset + pileBits > 64) {
+            value |= words[w + 1] << (64 - offset);
+        }
+        codes[p] = (PileCode)(value & mask);
+        bit += pileBits;
+    }
+}
+
+// Signature d'une pile indépendante des couleurs : longueur et positions où la
+// couleur change par rapport au jeton inférieur
+static uint32_t colorBlindSignature(PileCode code) {
+    if (code == 0) return 0;
+    int count = pileCount(code);
+    PileCode diff = code ^ (code >> PACK_BITS_PER_TOKEN);
+    diff = (diff | (diff >> 1) | (diff >> 2)) & 0x09249249u;
+    diff &= ((PileCode)1 << ((count - 1) * PACK_BITS_PER_TOKEN)) - 1;
+    return ((uint32_t)count << 24) | diff;
+}
+
+void packCanonical(const PackShape *shape, const PileCode *codes, uint64_t *words, int *order) {
+    int n = shape->numPiles;
+    int byShape[MAX_PILES];
+    uint32_t sig[MAX_PILES];
+
+    // 1. Ordonner les piles sans regarder les couleurs (tri par insertion stable, n <= 12)
+    for (int p = 0; p < n; p++) {
+        sig[p] = colorBlindSignature(codes[p]);
+        int i = p;
+        while (i > 0 && sig[byShape[i - 1]] < sig[p]) {
+            byShape[i] = byShape[i - 1];
+            i--;
+        }
+        byShape[i] = p;
+    }
+
+    // 2. Renommer les couleurs par ordre d'apparition
+    int rename[PACK_MAX_COLORS + 1] = {0};
+    int nextColor = 1;
+    PileCode renamed[MAX_PILES];
+    int source[MAX_PILES];
+    for (int k = 0; k < n; k++) {
+        PileCode code = codes[byShape[k]];
+        int count = pileCount(code);
+        PileCode out = 0;
+        for (int t = 0; t < count; t++) {
+            int cell = pileCell(code, t);
+            if (!rename[cell]) rename[cell] = nextColor++;
+            out |= (PileCode)rename[cell] << (t * PACK_BITS_PER_TOKEN);
+        }
+
+        // 3. Trier les piles renommées (ordre décroissant, les piles vides à la fin)
+        int i = k;
+        while (i > 0 && renamed[i - 1] < out) {
+            renamed[i] = renamed[i - 1];
+            source[i] = source[i - 1];
+            i--;
+        }
+        renamed[i] = out;
+        source[i] = byShape[k];
+    }
+
+    packBoard(shape, renamed, words);
+    if (order) memcpy(order, source, n * sizeof(int));
+}
+
+uint64_t packHash(const uint64_t *words, int numWords) {
+    uint64_t h = 0x9e3779b97f4a7c15ull;
+    for (int i = 0; i < numWords; i++) {
+        h = (h ^ words[i]) * 0xbf58476d1ce4e5b9ull;
+        h ^= h >> 31;
+    }
+    h *= 0x94d049bb133111ebull;
+    return h ^ (h >> 29);
+}
+
+// Un jeton posé au-dessus d'une couleur différente devra bouger, et pour chaque
+// couleur une seule base homogène peut rester en place. Dans la pile qui la garde,
+// chaque jeton de cette couleur posé plus haut devra sortir puis revenir : la base
+// retenue est celle qui maximise run moins ces jetons.
+int packHeuristic(const PackShape *shape, const PileCode *codes) {
+    int bestKept[PACK_MAX_COLORS + 1] = {0};
+    int sumRun[PACK_MAX_COLORS + 1] = {0};
+    int h = 0;
+
+    for (int p = 0; p < shape->numPiles; p++) {
+        PileCode code = codes[p];
+        if (code == 0) continue;
+        int count = pileCount(code);
+        int base = pileCell(code, 0);
+        // Comparer toute la pile à sa couleur de base répétée sur chaque case
+        PileCode mask = ((PileCode)1 << (count * PACK_BITS_PER_TOKEN)) - 1;
+        PileCode diff = (code ^ (base * 0x09249249u)) & mask;
+        int run = diff ? __builtin_ctz(diff) / PACK_BITS_PER_TOKEN : count;
+        h += count - run;
+        sumRun[base] += run;
+        // Une case par bit : jetons de la couleur de base, dans la base ou au-dessus
+        PileCode same = ~(diff | diff >> 1 | diff >> 2) & 0x09249249u & mask;
+        int kept = run - (__builtin_popcount(same) - run);
+        if (kept > bestKept[base]) bestKept[base] = kept;
+    }
+    for (int c = 1; c <= shape->numColors; c++) {
+        h += sumRun[c] - bestKept[c];
+    }
+    return h;
+}
+
+bool packTracePath(const PackShape *shape, const PileCode *start, const uint64_t *const *path,
+                   int length, unsigned char *from, unsigned char *to) {
+    size_t bytes = shape->words * sizeof(uint64_t);
+    uint64_t key[PACK_MAX_WORDS];
+
+    // real[i] = indice réel de la pile en position i du plateau canonique courant
+    int real[MAX_PILES];
+    packCanonical(shape, start, key, real);
+
+    for (int step = 0; step < length; step++) {
+        PileCode codes[MAX_PILES];
+        unpackBoard(shape, path[step], codes);
+        bool matched = false;
+
+        // Refaire le calcul de la recherche : développer le plateau canonique stocké
+        for (int f = 0; f < shape->numPiles && !matched; f++) {
+            if (codes[f] == 0) continue;
+            for (int t = 0; t < shape->numPiles && !matched; t++) {
+                if (t == f || pileCount(codes[t]) >= shape->maxTokens) continue;
+
+                PileCode child[MAX_PILES];
+                memcpy(child, codes, shape->numPiles * sizeof(PileCode));
+                child[t] = pilePush(child[t], pileTopCell(child[f]));
+                child[f] = pilePop(child[f]);
+
+                int order[MAX_PILES];
+                packCanonical(shape, child, key, order);
+                if (memcmp(key, path[step + 1], bytes) == 0) {
+                    from[step] = (unsigned char)real[f];
+                    to[step] = (unsigned char)real[t];
+                    int next[MAX_PILES];
+                    for (int i = 0; i < shape->numPiles; i++) next[i] = real[order[i]];
+                    memcpy(real, next, sizeof(next));
+                    matched = true;
+                }
+            }
+        }
+        if (!matched) return false;
+    }
+    return true;
+}
@@ -0,0 +1,75 @@
+#ifndef BOARDPACK_H
+#define BOARDPACK_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "game.h"
+
+// Forme compacte d'un plateau : 3 bits par jeton (couleur + 1, 0 = case vide).
+// La longueur d'une pile est implicite (les cases occupées sont contiguës depuis le bas).
+// Facile 4x3 = 36 bits, Moyen 6x4 = 72 bits, Difficile 8x5 = 120 bits : un ou deux mots.
+// La capacité reste celle des anciennes limites du jeu (12 piles de 6 jetons, 7 couleurs) :
+// PACK_MAX_WORDS fixe la taille des en-têtes de replay. Les plus grands plateaux se jouent
+// sans solveur ni enregistrement (packShapeInit retourne false).
+#define PACK_BITS_PER_TOKEN 3
+#define PACK_MAX_COLORS 7
+#define PACK_MAX_PILES 12
+#define PACK_MAX_TOKENS 6
+#define PACK_MAX_WORDS ((PACK_MAX_PILES * PACK_MAX_TOKENS * PACK_BITS_PER_TOKEN + 63) / 64)
+
+// Une pile : jeton du bas dans les bits de poids faible
+typedef uint32_t PileCode;
+
+typedef struct {
+    int numPiles;
+    int maxTokens;
+    int numColors;
+    int words;      // Nombre de mots de 64 bits utilisés par un plateau
+} PackShape;
+
+static inline int pileCount(PileCode code) {
+    return code ? (31 - __builtin_clz(code)) / PACK_BITS_PER_TOKEN + 1 : 0;
+}
+
+// Couleur (+ 1) du jeton d'indice i en partant du bas
+static inline int pileCell(PileCode code, int i) {
+    return (code >> (i * PACK_BITS_PER_TOKEN)) & 7;
+}
+
+static inline int pileTopCell(PileCode code) {
+    return pileCell(code, pileCount(code) - 1);
+}
+
+static inline PileCode pilePush(PileCode code, int cell) {
+    return code | ((PileCode)cell << (pileCount(code) * PACK_BITS_PER_TOKEN));
+}
+
+static inline PileCode pilePop(PileCode code) {
+    return code & ~((PileCode)7 << ((pileCount(code) - 1) * PACK_BITS_PER_TOKEN));
+}
+
+// Retourne false si le plateau dépasse les limites PACK_MAX_*
+bool packShapeInit(PackShape *shape, const GameState *game);
+
+void packFromGame(const PackShape *shape, const GameState *game, PileCode *codes);
+void packToGame(const PackShape *shape, const PileCode *codes, GameState *game);
+
+void packBoard(const PackShape *shape, const PileCode *codes, uint64_t *words);
+void unpackBoard(const PackShape *shape, const uint64_t *words, PileCode *codes);
+
+// Forme canonique : couleurs renommées par ordre d'apparition puis piles triées, de sorte
+// que la plupart des positions symétriques partagent la même clé. Si order n'est pas NULL,
+// order[i] reçoit l'indice dans codes de la pile placée en position i.
+void packCanonical(const PackShape *shape, const PileCode *codes, uint64_t *words, int *order);
+
+uint64_t packHash(const uint64_t *words, int numWords);
+
+// Borne inférieure admissible du nombre de coups restants (0 si et seulement si gagné)
+int packHeuristic(const PackShape *shape, const PileCode *codes);
+
+// Traduit un chemin de plateaux canoniques (path[0] = forme canonique de start, chaque
+// plateau étant un enfant du précédent) en coups dans la numérotation réelle de start
+bool packTracePath(const PackShape *shape, const PileCode *start, const uint64_t *const *path,
+                   int length, unsigned char *from, unsigned char *to);
+
+#endif
@@ -0,0 +1,176 @@
+// Outil hors-ligne : pré-rend les caractères ASCII des polices de l'interface dans un atlas
+// (glyphatlas.h) que le jeu projette en mémoire au démarrage, sans ouvrir de police
+// Usage : fontbake [-o fichier] [-r police normale] [-b police grasse]
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "glyphatlas.h"
+
+#define ATLAS_WIDTH 512
+#define GLYPH_PADDING 1
+
+typedef struct {
+    const char *path;
+    int size;
+    GlyphStyle style;
+} BakeFont;
+
+// Opacité d'un glyphe rendu, rognée aux pixels non transparents
+typedef struct {
+    uint8_t *alpha;
+    int w;
+    int h;
+} GlyphImage;
+
+static bool renderGlyph(TTF_Font *font, Uint16 c, GlyphMetrics *metrics, GlyphImage *image) {
+    int minX, maxX, minY, maxY, advance;
+    memset(metrics, 0, sizeof(*metrics));
+    memset(image, 0, sizeof(*image));
+    metrics->advance = -1;
+    if (!TTF_GlyphIsProvided(font, c) || TTF_GlyphMetrics(font, c, &minX, &maxX, &minY, &maxY, &advance) != 0) {
+        return true;
+    }
+    metrics->advance = (int16_t)advance;
+
+    SDL_Color white = {255, 255, 255, 255};
+    SDL_Surface *rendered = TTF_RenderGlyph_Blended(font, c, white);
+    if (!rendered) return true;     // Rien à dessiner (espace)
+    SDL_Surface *surface = SDL_ConvertSurfaceFormat(rendered, SDL_PIXELFORMAT_RGBA32, 0);
+    SDL_FreeSurface(rendered);
+    if (!surface) return false;
+
+    // Boîte des pixels visibles ; son coin est le décalage depuis la plume et le haut de la ligne
+    const uint8_t *pixels = surface->pixels;
+    int left = surface->w, top = surface->h, right = -1, bottom = -1;
+    for (int y = 0; y < surface->h; y++) {
+        for (int x = 0; x < surface->w; x++) {
+            if (pixels[y * surface->pitch + x * 4 + 3] == 0) continue;
+            if (x < left) left = x;
+            if (x > right) right = x;
+            if (y < top) top = y;
+            if (y > bottom) bottom = y;
+        }
+    }
+    if (right >= 0) {
+        image->w = right - left + 1;
+        image->h = bottom - top + 1;
+        image->alpha = malloc((size_t)image->w * image->h);
+        if (!image->alpha) {
+            SDL_FreeSurface(surface);
+            return false;
+        }
+        for (int y = 0; y < image->h; y++) {
+            for (int x = 0; x < image->w; x++) {
+                image->alpha[y * image->w + x] = pixels[(top + y) * surface->pitch + (left + x) * 4 + 3];
+            }
+        }
+        metrics->w = (uint16_t)image->w;
+        metrics->h = (uint16_t)image->h;
+        metrics->offsetX = (int16_t)left;
+        metrics->offsetY = (int16_t)top;
+    }
+    SDL_FreeSurface(surface);
+    return true;
+}
+
+int main(int argc, char *argv[]) {
+    const char *output = GLYPH_ATLAS_DEFAULT_PATH;
+    BakeFont fonts[] = {
+        {UI_FONT_PATH, UI_FONT_SIZE, GLYPH_STYLE_REGULAR},
+        {UI_BOLD_FONT_PATH, UI_LARGE_FONT_SIZE, GLYPH_STYLE_BOLD},
+    };
+    int numFonts = (int)(sizeof(fonts) / sizeof(fonts[0]));
+
+    int opt;
+    while ((opt = getopt(argc, argv, "o:r:b:")) != -1) {
+        switch (opt) {
+            case 'o': output = optarg; break;
+            case 'r': fonts[0].path = optarg; break;
+            case 'b': fonts[1].path = optarg; break;
+            default:
+                fprintf(stderr, "Usage: %s [-o fichier] [-r police normale] [-b police grasse]\n", argv[0]);
+                return 1;
+        }
+    }
+
+    if (TTF_Init() != 0) {
+        fprintf(stderr, "Erreur d'initialisation de SDL_ttf: %s\n", TTF_GetError());
+        return 1;
+    }
+
+    static GlyphAtlasHeader header;
+    static GlyphImage images[GLYPH_MAX_FONTS][GLYPH_COUNT];
+    header.numFonts = (uint32_t)numFonts;
+    header.width = ATLAS_WIDTH;
+
+    // Rangement en étagères : les glyphes sont posés de gauche à droite, une nouvelle étagère
+    // commence quand la ligne est pleine
+    int shelfX = 0, shelfY = 0, shelfHeight = 0;
+    for (int f = 0; f < numFonts; f++) {
+        TTF_Font *font = TTF_OpenFont(fonts[f].path, fonts[f].size);
+        if (!font) {
+            fprintf(stderr, "Impossible d'ouvrir %s: %s\n", fonts[f].path, TTF_GetError());
+            TTF_Quit();
+            return 1;
+        }
+        GlyphFont *baked = &header.fonts[f];
+        baked->style = fonts[f].style;
+        baked->size = (uint32_t)fonts[f].size;
+        baked->height = TTF_FontHeight(font);
+
+        for (int i = 0; i < GLYPH_COUNT; i++) {
+            GlyphMetrics *metrics = &baked->glyphs[i];
+            GlyphImage *image = &images[f][i];
+            if (!renderGlyph(font, (Uint16)(GLYPH_FIRST + i), metrics, image)) {
+                fprintf(stderr, "Mémoire insuffisante\n");
+                TTF_CloseFont(font);
+                TTF_Quit();
+                return 1;
+            }
+            if (image->w == 0) continue;
+            if (shelfX + image->w > ATLAS_WIDTH) {
+                shelfX = 0;
+                shelfY += shelfHeight + GLYPH_PADDING;
+                shelfHeight = 0;
+            }
+            metrics->x = (uint16_t)shelfX;
+            metrics->y = (uint16_t)shelfY;
+            shelfX += image->w + GLYPH_PADDING;
+            if (image->h > shelfHeight) shelfHeight = image->h;
+        }
+        TTF_CloseFont(font);
+    }
+    TTF_Quit();
+    header.height = (uint32_t)(shelfY + shelfHeight);
+
+    uint8_t *pixels = calloc((size_t)header.width * header.height, 1);
+    if (!pixels) {
+        fprintf(stderr, "Mémoire insuffisante\n");
+        return 1;
+    }
+    int numGlyphs = 0;
+    for (int f = 0; f < numFonts; f++) {
+        for (int i = 0; i < GLYPH_COUNT; i++) {
+            const GlyphMetrics *metrics = &header.fonts[f].glyphs[i];
+            const GlyphImage *image = &images[f][i];
+            for (int y = 0; y < image->h; y++) {
+                memcpy(&pixels[(metrics->y + y) * header.width + metrics->x], &image->alpha[y * image->w], image->w);
+            }
+            numGlyphs += metrics->advance >= 0;
+            free(image->alpha);
+        }
+    }
+
+    bool ok = glyphAtlasWrite(output, &header, pixels);
+    free(pixels);
+    if (!ok) {
+        fprintf(stderr, "Impossible d'écrire %s\n", output);
+        return 1;
+    }
+    printf("%d glyphes (%d polices) écrits dans %s, atlas %ux%u\n",
+           numGlyphs, numFonts, output, header.width, header.height);
+    return 0;
+}
@@ -0,0 +1,133 @@
+#include "game.h"
+
+// Forme de LEVEL_CUSTOM, celle du niveau facile tant que setCustomShape n'a pas été appelé
+static int customPiles = 4;
+static int customTokens = 3;
+static int customColors = 3;
+
+bool isValidShape(int numPiles, int maxTokens, int numColors) {
+    return numPiles <= MAX_PILES && maxTokens >= 1 && maxTokens <= MAX_TOKENS &&
+           numColors >= 1 && numColors <= MAX_COLORS && numColors < numPiles;
+}
+
+bool setCustomShape(int numPiles, int maxTokens, int numColors) {
+    if (!isValidShape(numPiles, maxTokens, numColors)) return false;
+    customPiles = numPiles;
+    customTokens = maxTokens;
+    customColors = numColors;
+    return true;
+}
+
+void setLevelShape(GameState *game, DifficultyLevel level) {
+    switch (level) {
+        case LEVEL_EASY:
+            game->numColors = 3;
+            game->numPiles = 4;
+            game->maxTokens = 3;
+            break;
+        case LEVEL_MEDIUM:
+            game->numColors = 4;
+            game->numPiles = 6;
+            game->maxTokens = 4;
+            break;
+        case LEVEL_HARD:
+            game->numColors = 5;
+            game->numPiles = 8;
+            game->maxTokens = 5;
+            break;
+        case LEVEL_CUSTOM:
+            game->numColors = customColors;
+            game->numPiles = customPiles;
+            game->maxTokens = customTokens;
+            break;
+        default:
+            game->numColors = 3;
+            game->numPiles = 4;
+            game->maxTokens = 3;
+    }
+}
+
+// Un déplacement est valide si la source a un jeton et que la destination a de la place
+// (pas de contrainte de couleur)
+bool canMoveToken(const GameState *game, int from, int to) {
+    if (from == to || from < 0 || to < 0 || from >= game->numPiles || to >= game->numPiles) {
+        return false;
+    }
+    return game->piles[from].count > 0 && game->piles[to].count < game->maxTokens;
+}
+
+// Clé Zobrist calculée à la volée (splitmix64) : pas de table à initialiser ni à partager
+static inline uint64_t zobristKey(int pile, int rank, int color) {
+    uint64_t z = (uint64_t)((pile * MAX_TOKENS + rank) * MAX_COLORS + color + 1) * 0x9e3779b97f4a7c15ull;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
+
+static inline void updateSorted(GameState *game, int p) {
+    const Pile *pile = &game->piles[p];
+    bool sorted = pile->count == 0 || (pile->count == game->maxTokens && game->baseRun[p] == pile->count);
+    bool wasSorted = (game->sortedMask >> p) & 1;
+    if (sorted == wasSorted) return;
+    game->sortedMask ^= 1ull << p;
+    game->unsorted += sorted ? -1 : 1;
+}
+
+void gameInitInvariants(GameState *game) {
+    game->hash = 0;
+    game->sortedMask = 0;
+    game->unsorted = game->numPiles;
+    game->heuristic = 0;
+    for (int p = 0; p < game->numPiles; p++) {
+        const Pile *pile = &game->piles[p];
+        int run = 0;
+        while (run < pile->count && pile->colors[run] == pile->colors[0]) run++;
+        game->baseRun[p] = (uint8_t)run;
+        game->heuristic += pile->count - run;
+        for (int t = 0; t < pile->count; t++) {
+            game->hash ^= zobristKey(p, t, pile->colors[t]);
+        }
+        updateSorted(game, p);
+    }
+}
+
+// Transférer le jeton du haut de la pile source vers la destination (sans vérification),
+// en tenant les invariants à jour
+void moveToken(GameState *game, int from, int to) {
+    Pile *src = &game->piles[from];
+    Pile *dest = &game->piles[to];
+
+    int color = src->colors[--src->count];
+    game->hash ^= zobristKey(from, src->count, color);
+    if (game->baseRun[from] > src->count) game->baseRun[from]--;
+    else game->heuristic--;
+
+    if (game->baseRun[to] == dest->count && (dest->count == 0 || dest->colors[0] == color)) game->baseRun[to]++;
+    else game->heuristic++;
+    game->hash ^= zobristKey(to, dest->count, color);
+    dest->colors[dest->count++] = color;
+
+    updateSorted(game, from);
+    updateSorted(game, to);
+}
+
+bool checkWinScan(const GameState *game) {
+    // Une pile est triée si tous les jetons sont de la même couleur
+    for (int i = 0; i < game->numPiles; i++) {
+        if (game->piles[i].count > 0) {
+            int firstColor = game->piles[i].colors[0];
+            for (int j = 1; j < game->piles[i].count; j++) {
+                if (game->piles[i].colors[j] != firstColor) {
+                    return false;
+                }
+            }
+            
+            // Si la pile n'est pas complète (maxTokens jetons) avec la même couleur
+            if (game->piles[i].count != game->maxTokens && game->piles[i].count != 0) {
+                return false;
+            }
+        }
+    }
+    
+    return true;
+}
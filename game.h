@@ -0,0 +1,78 @@
+#ifndef GAME_H
+#define GAME_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Plateaux jusqu'à 64 piles (un bit par pile dans sortedMask) de 16 jetons, 32 couleurs
+#define MAX_PILES 64
+#define MAX_TOKENS 16
+#define MAX_COLORS 32
+
+typedef enum {
+    LEVEL_NONE,
+    LEVEL_EASY,
+    LEVEL_MEDIUM,
+    LEVEL_HARD,
+    LEVEL_CUSTOM        // Forme choisie par setCustomShape
+} DifficultyLevel;
+
+typedef enum {
+    GAME_PLAYING,
+    GAME_WON
+} GameStatus;
+
+typedef struct {
+    int colors[MAX_TOKENS];
+    int count;
+} Pile;
+
+// Pas de dépendance à SDL ici : uint32_t est le type sous-jacent de Uint32,
+// ce qui permet au solveur et aux outils hors-ligne d'utiliser GameState.
+typedef struct {
+    Pile piles[MAX_PILES];
+    int numPiles;
+    int maxTokens;
+    int numColors;
+    int selected;
+    GameStatus status;
+    DifficultyLevel currentLevel;
+    int moveCount;
+    uint32_t startTime;
+    uint32_t endTime;  // Ajouter cette ligne pour stocker le temps de fin
+    uint64_t seed;     // Graine du générateur ayant produit le plateau
+
+    // Invariants tenus à jour en O(1) par moveToken (voir gameInitInvariants)
+    uint64_t hash;                  // Zobrist des (pile, rang, couleur) occupés
+    uint64_t sortedMask;            // Bit i : pile i vide, ou pleine d'une seule couleur
+    int unsorted;                   // Piles hors de sortedMask : 0 si et seulement si gagné
+    int heuristic;                  // Jetons au-dessus de la base unicolore de leur pile :
+                                    // chacun doit bouger au moins une fois
+    uint8_t baseRun[MAX_PILES];     // Jetons du bas de la couleur du premier
+} GameState;
+
+// Dimensions (piles, couleurs, jetons par pile) associées à un niveau
+void setLevelShape(GameState *game, DifficultyLevel level);
+
+// Forme dans les limites ci-dessus, avec au moins une pile libre
+bool isValidShape(int numPiles, int maxTokens, int numColors);
+
+// Forme de LEVEL_CUSTOM ; false (et forme inchangée) si !isValidShape
+bool setCustomShape(int numPiles, int maxTokens, int numColors);
+
+// Recalcule les invariants après avoir rempli les piles directement
+void gameInitInvariants(GameState *game);
+
+// Règles du jeu (sans SDL)
+bool canMoveToken(const GameState *game, int from, int to);
+void moveToken(GameState *game, int from, int to);
+
+// Victoire : une comparaison sur les invariants
+static inline bool checkWin(const GameState *game) {
+    return game->unsorted == 0;
+}
+
+// Même résultat en parcourant tous les jetons (référence, n'utilise pas les invariants)
+bool checkWinScan(const GameState *game);
+
+#endif
@@ -0,0 +1,124 @@
+#include "generator.h"
+
+typedef struct {
+    uint64_t s[4];
+} Rng;
+
+static _Thread_local Rng threadRng = {{
+    0x9e3779b97f4a7c15ull, 0xbf58476d1ce4e5b9ull, 0x94d049bb133111ebull, 0x2545f4914f6cdd1dull
+}};
+
+static uint64_t splitmix64(uint64_t *x) {
+    uint64_t z = (*x += 0x9e3779b97f4a7c15ull);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
+
+static inline uint64_t rotl(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+static void seedRng(Rng *rng, uint64_t seed) {
+    for (int i = 0; i < 4; i++) {
+        rng->s[i] = splitmix64(&seed);
+    }
+}
+
+static inline uint64_t nextRng(Rng *rng) {
+    uint64_t *s = rng->s;
+    uint64_t result = rotl(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl(s[3], 45);
+    return result;
+}
+
+static inline uint32_t rangeRng(Rng *rng, uint32_t n) {
+    // Multiplication 32x32 -> 64 bits (Lemire), sans division ni rejet
+    return (uint32_t)(((nextRng(rng) >> 32) * n) >> 32);
+}
+
+void rngSeed(uint64_t seed) {
+    seedRng(&threadRng, seed);
+}
+
+uint64_t rngNext(void) {
+    return nextRng(&threadRng);
+}
+
+uint32_t rngRange(uint32_t n) {
+    return rangeRng(&threadRng, n);
+}
+
+// Indice du k-ième bit à 1 de mask
+static int nthSetBit(uint64_t mask, uint32_t k) {
+    while (k--) mask &= mask - 1;
+    return __builtin_ctzll(mask);
+}
+
+int defaultScrambleMoves(const GameState *game) {
+    // 6 coups par jeton : difficulté moyenne (coups optimaux) proche des anciens tirages aléatoires
+    return 6 * game->numColors * game->maxTokens;
+}
+
+void generateBoard(GameState *game, uint64_t seed, int scrambleMoves) {
+    // Générateur local : le plateau ne dépend que de la graine, pas de l'état du thread
+    Rng rng;
+    seedRng(&rng, seed);
+
+    for (int i = 0; i < MAX_PILES; i++) {
+        game->piles[i].count = 0;
+    }
+
+    // Plateau résolu : une pile pleine par couleur, placées aléatoirement
+    int order[MAX_PILES];
+    for (int i = 0; i < game->numPiles; i++) {
+        int j = (int)rangeRng(&rng, i + 1);
+        if (j != i) order[i] = order[j];
+        order[j] = i;
+    }
+    for (int c = 0; c < game->numColors; c++) {
+        Pile *pile = &game->piles[order[c]];
+        for (int t = 0; t < game->maxTokens; t++) {
+            pile->colors[t] = c;
+        }
+        pile->count = game->maxTokens;
+    }
+    gameInitInvariants(game);
+
+    // Masques des piles non vides / non pleines, tenus à jour à chaque coup
+    uint64_t nonEmpty = 0, nonFull = 0;
+    for (int i = 0; i < game->numPiles; i++) {
+        if (game->piles[i].count > 0) nonEmpty |= 1ull << i;
+        if (game->piles[i].count < game->maxTokens) nonFull |= 1ull << i;
+    }
+
+    // Les coups sont réversibles (seule la place compte), donc des coups aléatoires
+    // depuis la solution sont des « coups inverses » valides. Le mélange continue si
+    // le hasard retombe sur un plateau résolu.
+    int lastFrom = -1, lastTo = -1;
+    int limit = scrambleMoves + game->numPiles * game->maxTokens;
+    for (int step = 0; step < limit; step++) {
+        if (step >= scrambleMoves && !checkWin(game)) break;
+
+        int from = nthSetBit(nonEmpty, rangeRng(&rng, __builtin_popcountll(nonEmpty)));
+        uint64_t targets = nonFull & ~(1ull << from);
+        // Ne pas annuler le coup précédent, sauf s'il n'y a pas d'autre choix
+        if (from == lastTo && (targets & ~(1ull << lastFrom))) targets &= ~(1ull << lastFrom);
+        if (!targets) continue;
+        int to = nthSetBit(targets, rangeRng(&rng, __builtin_popcountll(targets)));
+
+        moveToken(game, from, to);
+        if (game->piles[from].count == 0) nonEmpty &= ~(1ull << from);
+        nonFull |= 1ull << from;
+        nonEmpty |= 1ull << to;
+        if (game->piles[to].count == game->maxTokens) nonFull &= ~(1ull << to);
+        lastFrom = from;
+        lastTo = to;
+    }
+}
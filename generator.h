@@ -0,0 +1,22 @@
+#ifndef GENERATOR_H
+#define GENERATOR_H
+
+#include <stdint.h>
+#include "game.h"
+
+// Générateur pseudo-aléatoire (xoshiro256**) propre à chaque thread
+void rngSeed(uint64_t seed);
+uint64_t rngNext(void);
+uint32_t rngRange(uint32_t n);    // Entier dans [0, n)
+
+// Nombre de coups de mélange par défaut pour la forme de plateau de game
+int defaultScrambleMoves(const GameState *game);
+
+// Part d'un plateau résolu (numPiles/maxTokens/numColors déjà renseignés) et applique
+// scrambleMoves coups légaux aléatoires : O(scrambleMoves), jamais de boucle de rejet.
+// Le plateau dépend uniquement de seed. Si le plateau est encore résolu après scrambleMoves
+// coups, le mélange continue, jusqu'à scrambleMoves + numPiles * maxTokens coups au plus :
+// c'est la borne de la distance à la solution.
+void generateBoard(GameState *game, uint64_t seed, int scrambleMoves);
+
+#endif
@@ -0,0 +1,96 @@
+#include "glyphatlas.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Toutes les régions doivent tenir dans l'image
+static bool validFont(const GlyphFont *font, uint32_t width, uint32_t height) {
+    for (int i = 0; i < GLYPH_COUNT; i++) {
+        const GlyphMetrics *glyph = &font->glyphs[i];
+        if ((uint32_t)glyph->x + glyph->w > width || (uint32_t)glyph->y + glyph->h > height) return false;
+    }
+    return font->height > 0;
+}
+
+bool glyphAtlasOpen(GlyphAtlas *atlas, const char *path) {
+    memset(atlas, 0, sizeof(*atlas));
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(GlyphAtlasHeader)) {
+        close(fd);
+        return false;
+    }
+    void *map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return false;
+
+    // Vérifications de cohérence seulement : les pixels sont utilisés tels quels
+    const GlyphAtlasHeader *header = map;
+    size_t size = (size_t)st.st_size;
+    bool valid = memcmp(header->magic, GLYPH_ATLAS_MAGIC, sizeof(header->magic)) == 0 &&
+                 header->version == GLYPH_ATLAS_VERSION &&
+                 header->numFonts <= GLYPH_MAX_FONTS &&
+                 header->width > 0 &&
+                 header->pixelsOffset <= size &&
+                 (size - header->pixelsOffset) / header->width >= header->height;
+    for (uint32_t i = 0; valid && i < header->numFonts; i++) {
+        valid = validFont(&header->fonts[i], header->width, header->height);
+    }
+    if (!valid) {
+        munmap(map, size);
+        return false;
+    }
+
+    atlas->map = map;
+    atlas->size = size;
+    atlas->header = header;
+    atlas->pixels = (const uint8_t *)map + header->pixelsOffset;
+    return true;
+}
+
+void glyphAtlasClose(GlyphAtlas *atlas) {
+    if (atlas->map) munmap(atlas->map, atlas->size);
+    memset(atlas, 0, sizeof(*atlas));
+}
+
+const GlyphFont *glyphAtlasFont(const GlyphAtlas *atlas, GlyphStyle style, int size) {
+    if (!atlas || !atlas->header) return NULL;
+    for (uint32_t i = 0; i < atlas->header->numFonts; i++) {
+        const GlyphFont *font = &atlas->header->fonts[i];
+        if (font->style == (uint32_t)style && font->size == (uint32_t)size) return font;
+    }
+    return NULL;
+}
+
+bool glyphFontMeasure(const GlyphFont *font, const char *text, int *width) {
+    bool complete = true;
+    *width = 0;
+    for (const unsigned char *c = (const unsigned char *)text; *c; c++) {
+        const GlyphMetrics *glyph = glyphFontGlyph(font, *c);
+        if (glyph) *width += glyph->advance;
+        else complete = false;
+    }
+    return complete;
+}
+
+bool glyphAtlasWrite(const char *path, GlyphAtlasHeader *header, const uint8_t *pixels) {
+    memcpy(header->magic, GLYPH_ATLAS_MAGIC, sizeof(header->magic));
+    header->version = GLYPH_ATLAS_VERSION;
+    // Pixels alignés sur 64 octets
+    header->pixelsOffset = (sizeof(*header) + 63) & ~(uint64_t)63;
+
+    FILE *file = fopen(path, "wb");
+    if (!file) return false;
+    static const char padding[64] = {0};
+    size_t paddingSize = header->pixelsOffset - sizeof(*header);
+    size_t numPixels = (size_t)header->width * header->height;
+    bool ok = fwrite(header, sizeof(*header), 1, file) == 1 &&
+              fwrite(padding, 1, paddingSize, file) == paddingSize &&
+              fwrite(pixels, 1, numPixels, file) == numPixels;
+    return fclose(file) == 0 && ok;
+}
@@ -0,0 +1,85 @@
+#ifndef GLYPHATLAS_H
+#define GLYPHATLAS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Glyphes pré-rendus des polices de l'interface (make glyphs), projetés en mémoire (mmap)
+// comme le fichier de niveaux :
+//   en-tête (métriques de chaque police) | opacité 8 bits de l'atlas, ligne par ligne
+// Les entiers sont stockés en petit-boutiste (ordre natif des machines visées).
+#define GLYPH_ATLAS_MAGIC "NUTSGLYF"
+#define GLYPH_ATLAS_VERSION 1
+#define GLYPH_ATLAS_DEFAULT_PATH "glyphs.atlas"
+#define GLYPH_FIRST 32          // ASCII imprimable : tous les textes du jeu
+#define GLYPH_COUNT 95
+#define GLYPH_MAX_FONTS 4
+
+// Polices de l'interface : pré-rendues par fontbake, ouvertes par SDL_ttf en secours
+#define UI_FONT_PATH "/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf"
+#define UI_BOLD_FONT_PATH "/usr/share/fonts/truetype/dejavu/DejaVuSans-Bold.ttf"
+#define UI_FONT_SIZE 24
+#define UI_LARGE_FONT_SIZE 36
+
+typedef enum {
+    GLYPH_STYLE_REGULAR,
+    GLYPH_STYLE_BOLD
+} GlyphStyle;
+
+typedef struct {
+    uint16_t x;             // Région de l'atlas (w = 0 : rien à dessiner, comme l'espace)
+    uint16_t y;
+    uint16_t w;
+    uint16_t h;
+    int16_t offsetX;        // Position de la région depuis la plume et le haut de la ligne
+    int16_t offsetY;
+    int16_t advance;        // -1 : caractère absent de la police
+    uint16_t reserved;
+} GlyphMetrics;
+
+typedef struct {
+    uint32_t style;         // GlyphStyle
+    uint32_t size;          // Taille en points passée à TTF_OpenFont
+    int32_t height;         // Hauteur de ligne (celle des surfaces de SDL_ttf)
+    uint32_t reserved;
+    GlyphMetrics glyphs[GLYPH_COUNT];
+} GlyphFont;
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t numFonts;
+    uint32_t width;
+    uint32_t height;
+    uint64_t pixelsOffset;
+    GlyphFont fonts[GLYPH_MAX_FONTS];
+} GlyphAtlasHeader;
+
+typedef struct {
+    void *map;
+    size_t size;
+    const GlyphAtlasHeader *header;
+    const uint8_t *pixels;  // width x height octets
+} GlyphAtlas;
+
+bool glyphAtlasOpen(GlyphAtlas *atlas, const char *path);
+void glyphAtlasClose(GlyphAtlas *atlas);
+
+// Police pré-rendue de ce style et de cette taille ; NULL si l'atlas ne l'a pas
+const GlyphFont *glyphAtlasFont(const GlyphAtlas *atlas, GlyphStyle style, int size);
+
+// Métriques du caractère c ; NULL s'il n'est pas dans l'atlas
+static inline const GlyphMetrics *glyphFontGlyph(const GlyphFont *font, unsigned char c) {
+    if (c < GLYPH_FIRST || c >= GLYPH_FIRST + GLYPH_COUNT) return NULL;
+    const GlyphMetrics *glyph = &font->glyphs[c - GLYPH_FIRST];
+    return glyph->advance < 0 ? NULL : glyph;
+}
+
+// Largeur du texte (somme des avances) ; false si un caractère manque à l'atlas
+bool glyphFontMeasure(const GlyphFont *font, const char *text, int *width);
+
+// Écrit l'en-tête (magic, version et pixelsOffset sont remplis ici) puis les pixels
+bool glyphAtlasWrite(const char *path, GlyphAtlasHeader *header, const uint8_t *pixels);
+
+#endif
@@ -0,0 +1,95 @@
+#include "hint.h"
+#include "solver.h"
+
+static uint64_t packMailbox(uint32_t generation, HintStatus status, int from, int to) {
+    return (uint64_t)generation << 32 | (uint64_t)status << 16 | (uint64_t)(from & 0xff) << 8 | (uint64_t)(to & 0xff);
+}
+
+static void *hintWorker(void *arg) {
+    HintEngine *engine = arg;
+    for (;;) {
+        pthread_mutex_lock(&engine->lock);
+        while (!engine->hasPending && !engine->quit) {
+            pthread_cond_wait(&engine->wake, &engine->lock);
+        }
+        if (engine->quit) {
+            pthread_mutex_unlock(&engine->lock);
+            break;
+        }
+        GameState game = engine->pending;
+        uint32_t generation = engine->pendingGeneration;
+        engine->hasPending = false;
+        atomic_store(&engine->cancel, false);
+        pthread_mutex_unlock(&engine->lock);
+
+        SolverResult result;
+        bool solved = solveGameCancellable(&game, HINT_MAX_NODES, &engine->cancel, &result);
+        if (atomic_load(&engine->cancel)) continue;
+
+        uint64_t message = solved && result.numMoves > 0
+            ? packMailbox(generation, HINT_FOUND, result.moves[0].from, result.moves[0].to)
+            : packMailbox(generation, HINT_NONE, 0, 0);
+        atomic_store_explicit(&engine->mailbox, message, memory_order_release);
+        if (engine->notify) engine->notify();
+    }
+    return NULL;
+}
+
+bool hintStart(HintEngine *engine, void (*notify)(void)) {
+    engine->notify = notify;
+    engine->hasPending = false;
+    engine->quit = false;
+    engine->generation = 0;
+    atomic_init(&engine->cancel, false);
+    atomic_init(&engine->mailbox, 0);
+    pthread_mutex_init(&engine->lock, NULL);
+    pthread_cond_init(&engine->wake, NULL);
+    engine->started = pthread_create(&engine->thread, NULL, hintWorker, engine) == 0;
+    if (!engine->started) {
+        pthread_mutex_destroy(&engine->lock);
+        pthread_cond_destroy(&engine->wake);
+    }
+    return engine->started;
+}
+
+void hintStop(HintEngine *engine) {
+    if (!engine->started) return;
+    pthread_mutex_lock(&engine->lock);
+    engine->quit = true;
+    atomic_store(&engine->cancel, true);
+    pthread_cond_signal(&engine->wake);
+    pthread_mutex_unlock(&engine->lock);
+    pthread_join(engine->thread, NULL);
+    pthread_mutex_destroy(&engine->lock);
+    pthread_cond_destroy(&engine->wake);
+    engine->started = false;
+}
+
+void hintRequest(HintEngine *engine, const GameState *game) {
+    if (!engine->started) return;
+    engine->generation++;
+    pthread_mutex_lock(&engine->lock);
+    engine->pending = *game;
+    engine->pendingGeneration = engine->generation;
+    engine->hasPending = true;
+    atomic_store(&engine->cancel, true);    // Abandonner la recherche précédente
+    pthread_cond_signal(&engine->wake);
+    pthread_mutex_unlock(&engine->lock);
+}
+
+void hintCancel(HintEngine *engine) {
+    if (!engine->started) return;
+    engine->generation++;
+    pthread_mutex_lock(&engine->lock);
+    engine->hasPending = false;
+    atomic_store(&engine->cancel, true);
+    pthread_mutex_unlock(&engine->lock);
+}
+
+HintStatus hintPoll(const HintEngine *engine, int *from, int *to) {
+    uint64_t message = atomic_load_explicit(&engine->mailbox, memory_order_acquire);
+    if ((uint32_t)(message >> 32) != engine->generation) return HINT_PENDING;
+    *from = (int)(message >> 8) & 0xff;
+    *to = (int)message & 0xff;
+    return (HintStatus)((message >> 16) & 0xff);
+}
@@ -0,0 +1,51 @@
+#ifndef HINT_H
+#define HINT_H
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "game.h"
+
+// Recherche du meilleur coup sur un thread dédié, sans SDL. Le thread principal dépose une
+// copie du plateau ; le résultat revient par une boîte aux lettres sans verrou (un mot
+// atomique portant le numéro de la demande), relue à chaque image par hintPoll.
+// Toute demande ou annulation interrompt la recherche en cours à la prochaine vérification.
+#define HINT_MAX_NODES 2000000
+
+typedef enum {
+    HINT_PENDING,       // Pas (encore) de réponse pour la dernière demande
+    HINT_FOUND,
+    HINT_NONE           // Plateau insoluble, ou borne de recherche atteinte
+} HintStatus;
+
+typedef struct {
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    bool started;
+
+    // Protégés par lock
+    GameState pending;
+    uint32_t pendingGeneration;
+    bool hasPending;
+    bool quit;
+
+    atomic_bool cancel;
+    _Atomic uint64_t mailbox;   // (génération << 32) | (statut << 16) | (source << 8) | destination
+    uint32_t generation;        // Dernière demande (thread principal seulement)
+    void (*notify)(void);       // Appelé par le thread de recherche quand un résultat est posté
+} HintEngine;
+
+// notify peut être NULL (le thread principal relit alors la boîte à chaque image)
+bool hintStart(HintEngine *engine, void (*notify)(void));
+void hintStop(HintEngine *engine);
+
+void hintRequest(HintEngine *engine, const GameState *game);
+
+// Oublie la demande en cours (à appeler dès que le plateau change)
+void hintCancel(HintEngine *engine);
+
+HintStatus hintPoll(const HintEngine *engine, int *from, int *to);
+
+#endif
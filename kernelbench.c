@@ -0,0 +1,145 @@
+// Banc des noyaux de plateau (make bench-kernels) : sur des plateaux générés de chaque forme
+// de niveau, compare les noyaux vectoriels de simdkernel (victoire, coups légaux, sommets) au
+// noyau scalaire et aux fonctions de référence. Une ligne JSON par noyau.
+// Usage : kernelbench [-n plateaux par forme] [-r passes] [-s graine]
+#include "generator.h"
+#include "simdkernel.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+typedef struct {
+    const char *name;
+    int numPiles;
+    int maxTokens;
+    int numColors;
+} BenchShape;
+
+// Les trois niveaux, une forme personnalisée et la plus grande forme du jeu
+static const BenchShape shapes[] = {
+    {"easy", 4, 3, 3},
+    {"medium", 6, 4, 4},
+    {"hard", 8, 5, 5},
+    {"custom", 10, 6, 6},
+    {"large", MAX_PILES, MAX_TOKENS, MAX_COLORS},
+};
+
+static double now(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+// Test de victoire, coups légaux et sommets de chaque plateau ; retourne une somme de contrôle
+static uint64_t scanAll(const SimdKernel *kernel, const ByteBoard *boards, int numBoards, int passes) {
+    static KernelMove moves[SIMD_MAX_MOVES];
+    uint64_t checksum = 0;
+    for (int pass = 0; pass < passes; pass++) {
+        for (int b = 0; b < numBoards; b++) {
+            uint8_t tops[MAX_PILES];
+            kernel->topTokens(&boards[b], tops);
+            int numMoves = simdGenerateMoves(kernel, &boards[b], moves);
+            checksum = checksum * 31 + simdCheckWin(kernel, &boards[b]) * 2 + (uint64_t)numMoves;
+            if (numMoves > 0) checksum += tops[moves[numMoves / 2].from];
+        }
+    }
+    return checksum;
+}
+
+// Compare un noyau vectoriel à checkWinScan, aux invariants et à canMoveToken
+static int checkSimdKernel(const SimdKernel *kernel, const GameState *game, const ByteBoard *board) {
+    static KernelMove moves[SIMD_MAX_MOVES];
+    if (simdCheckWin(kernel, board) != checkWinScan(game)) return 1;
+    if (kernel->sortedMask(board) != game->sortedMask) return 1;
+
+    uint8_t tops[MAX_PILES];
+    kernel->topTokens(board, tops);
+    int legal = 0;
+    for (int p = 0; p < game->numPiles; p++) {
+        const Pile *pile = &game->piles[p];
+        if (tops[p] != (pile->count ? pile->colors[pile->count - 1] + 1 : 0)) return 1;
+        for (int q = 0; q < game->numPiles; q++) legal += canMoveToken(game, p, q);
+    }
+
+    int numMoves = simdGenerateMoves(kernel, board, moves);
+    int errors = numMoves != legal;
+    for (int m = 0; m < numMoves; m++) {
+        errors += !canMoveToken(game, moves[m].from, moves[m].to);
+    }
+    return errors;
+}
+
+// Noyaux vectoriels, comparés au scalaire (le premier de la liste)
+static int benchSimd(const BenchShape *bench, GameState *game, int numBoards, int passes, uint64_t seed) {
+    ByteBoard *boards = malloc((size_t)numBoards * sizeof(ByteBoard));
+    if (!boards) {
+        fprintf(stderr, "Mémoire insuffisante\n");
+        return 1;
+    }
+
+    int errors = 0;
+    for (int b = 0; b < numBoards; b++) {
+        uint64_t boardSeed = seed + b;
+        generateBoard(game, boardSeed, (int)(boardSeed % (defaultScrambleMoves(game) + 1)));
+        byteBoardFromGame(game, &boards[b]);
+        for (int k = 0; k < simdKernelCount(); k++) {
+            errors += checkSimdKernel(simdKernelAt(k), game, &boards[b]);
+        }
+    }
+
+    uint64_t scalarSum = 0;
+    double scalarTime = 0;
+    for (int k = 0; k < simdKernelCount(); k++) {
+        const SimdKernel *kernel = simdKernelAt(k);
+        double start = now();
+        uint64_t sum = scanAll(kernel, boards, numBoards, passes);
+        double time = now() - start;
+        double rate = (double)numBoards * passes / time;
+        if (k == 0) {
+            scalarSum = sum;
+            scalarTime = time;
+            printf("{\"shape\":\"%s\",\"kernel\":\"%s\",\"boards_per_sec\":%.0f}\n",
+                   bench->name, kernel->name, rate);
+        } else {
+            int kernelErrors = errors + (sum != scalarSum);
+            printf("{\"shape\":\"%s\",\"kernel\":\"%s\",\"boards_per_sec\":%.0f,\"speedup\":%.2f,\"errors\":%d}\n",
+                   bench->name, kernel->name, rate, scalarTime / time, kernelErrors);
+            errors = kernelErrors;
+        }
+    }
+    free(boards);
+    return errors;
+}
+
+int main(int argc, char *argv[]) {
+    int numBoards = 20000;
+    int passes = 20;
+    uint64_t seed = 1;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "n:r:s:")) != -1) {
+        switch (opt) {
+            case 'n': numBoards = atoi(optarg); break;
+            case 'r': passes = atoi(optarg); break;
+            case 's': seed = strtoull(optarg, NULL, 10); break;
+            default:
+                fprintf(stderr, "Usage: %s [-n plateaux par forme] [-r passes] [-s graine]\n", argv[0]);
+                return 1;
+        }
+    }
+    if (numBoards < 1) numBoards = 1;
+    if (passes < 1) passes = 1;
+
+    int failures = 0;
+    for (size_t i = 0; i < sizeof(shapes) / sizeof(shapes[0]); i++) {
+        GameState game;
+        memset(&game, 0, sizeof(game));
+        game.numPiles = shapes[i].numPiles;
+        game.maxTokens = shapes[i].maxTokens;
+        game.numColors = shapes[i].numColors;
+        failures += benchSimd(&shapes[i], &game, numBoards, passes, seed + ((uint64_t)i << 48));
+    }
+    return failures ? 1 : 0;
+}
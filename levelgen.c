@@ -0,0 +1,164 @@
+// Outil hors-ligne : génère, vérifie et évalue des plateaux puis écrit un fichier de niveaux
+// Usage : levelgen [-o fichier] [-n plateaux par niveau] [-j threads] [-s graine]
+#include "boardpack.h"
+#include "generator.h"
+#include "levelpack.h"
+#include "solver.h"
+#include "transtable.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define RATING_MAX_NODES 500000
+#define MAX_ROUNDS 8
+
+typedef struct {
+    DifficultyLevel level;
+    uint64_t baseSeed;
+    uint32_t count;
+    LevelRecord *records;
+    bool *accepted;
+    _Atomic uint32_t next;
+} Batch;
+
+// Plateaux trop proches de la solution refusés
+static int minimumMoves(const GameState *game) {
+    return game->numColors + game->maxTokens - 1;
+}
+
+static void *rateWorker(void *arg) {
+    Batch *batch = arg;
+    for (;;) {
+        uint32_t i = atomic_fetch_add(&batch->next, 1);
+        if (i >= batch->count) break;
+
+        GameState game;
+        memset(&game, 0, sizeof(game));
+        setLevelShape(&game, batch->level);
+        game.seed = batch->baseSeed + i;
+        generateBoard(&game, game.seed, defaultScrambleMoves(&game));
+
+        SolverResult result;
+        batch->accepted[i] = solveGame(&game, RATING_MAX_NODES, &result) &&
+                             result.numMoves >= minimumMoves(&game) &&
+                             levelRecordFromGame(&batch->records[i], &game, batch->level, result.numMoves);
+    }
+    return NULL;
+}
+
+static void rateBatch(Batch *batch, int numThreads) {
+    pthread_t threads[64];
+    int started = 0;
+    atomic_store(&batch->next, 0);
+    while (started < numThreads && pthread_create(&threads[started], NULL, rateWorker, batch) == 0) {
+        started++;
+    }
+    if (started == 0) rateWorker(batch);
+    for (int t = 0; t < started; t++) {
+        pthread_join(threads[t], NULL);
+    }
+}
+
+// Ajoute les plateaux retenus du lot en écartant les doublons (à symétrie près)
+static uint32_t collectBatch(const Batch *batch, TransTable *seen, LevelRecord *out, uint32_t wanted) {
+    uint32_t added = 0;
+    for (uint32_t i = 0; i < batch->count && added < wanted; i++) {
+        if (!batch->accepted[i]) continue;
+        const LevelRecord *record = &batch->records[i];
+
+        GameState game;
+        memset(&game, 0, sizeof(game));
+        if (!levelRecordToGame(record, &game)) continue;
+        PackShape shape;
+        packShapeInit(&shape, &game);
+        PileCode codes[MAX_PILES];
+        packFromGame(&shape, &game, codes);
+        // seen compare LEVELPACK_BOARD_WORDS mots : ceux au-delà de shape.words restent à zéro
+        uint64_t key[PACK_MAX_WORDS] = {0};
+        packCanonical(&shape, codes, key, NULL);
+
+        bool found;
+        uint32_t *value = ttInsert(seen, key, packHash(key, shape.words), &found);
+        if (!value || found) continue;
+        *value = 1;
+        out[added++] = *record;
+    }
+    return added;
+}
+
+int main(int argc, char *argv[]) {
+    const char *output = LEVELPACK_DEFAULT_PATH;
+    uint32_t perLevel = 1000;
+    int numThreads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    uint64_t seed = 1;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "o:n:j:s:")) != -1) {
+        switch (opt) {
+            case 'o': output = optarg; break;
+            case 'n': perLevel = (uint32_t)strtoul(optarg, NULL, 10); break;
+            case 'j': numThreads = atoi(optarg); break;
+            case 's': seed = strtoull(optarg, NULL, 10); break;
+            default:
+                fprintf(stderr, "Usage: %s [-o fichier] [-n plateaux par niveau] [-j threads] [-s graine]\n", argv[0]);
+                return 1;
+        }
+    }
+    if (numThreads < 1) numThreads = 1;
+    if (numThreads > 64) numThreads = 64;
+
+    uint32_t capacity = perLevel * (LEVELPACK_NUM_LEVELS - 1);
+    LevelRecord *records = malloc((capacity ? capacity : 1) * sizeof(LevelRecord));
+    if (!records) {
+        fprintf(stderr, "Mémoire insuffisante\n");
+        return 1;
+    }
+    uint32_t numRecords = 0;
+
+    for (DifficultyLevel level = LEVEL_EASY; level <= LEVEL_HARD; level++) {
+        TransTable seen;
+        if (!ttInit(&seen, LEVELPACK_BOARD_WORDS, perLevel * 2)) {
+            fprintf(stderr, "Mémoire insuffisante\n");
+            return 1;
+        }
+
+        uint32_t have = 0;
+        uint64_t nextSeed = seed + ((uint64_t)level << 48);
+        clock_t start = clock();
+        for (int round = 0; round < MAX_ROUNDS && have < perLevel; round++) {
+            Batch batch;
+            batch.level = level;
+            batch.baseSeed = nextSeed;
+            batch.count = (perLevel - have) + (perLevel - have) / 4 + 16;
+            batch.records = malloc(batch.count * sizeof(LevelRecord));
+            batch.accepted = calloc(batch.count, sizeof(bool));
+            if (!batch.records || !batch.accepted) {
+                fprintf(stderr, "Mémoire insuffisante\n");
+                return 1;
+            }
+
+            rateBatch(&batch, numThreads);
+            have += collectBatch(&batch, &seen, &records[numRecords + have], perLevel - have);
+            nextSeed += batch.count;
+            free(batch.records);
+            free(batch.accepted);
+        }
+        ttFree(&seen);
+
+        printf("Niveau %d : %u plateaux (%.1f s CPU)\n", level, have, (double)(clock() - start) / CLOCKS_PER_SEC);
+        numRecords += have;
+    }
+
+    if (!levelPackWrite(output, records, numRecords)) {
+        fprintf(stderr, "Impossible d'écrire %s\n", output);
+        free(records);
+        return 1;
+    }
+    printf("%u niveaux écrits dans %s\n", numRecords, output);
+    free(records);
+    return 0;
+}
@@ -0,0 +1,138 @@
+#include "levelpack.h"
+#include "boardpack.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+bool levelPackOpen(LevelPack *pack, const char *path) {
+    memset(pack, 0, sizeof(*pack));
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(LevelPackHeader)) {
+        close(fd);
+        return false;
+    }
+    void *map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return false;
+
+    // Vérifications de cohérence seulement : aucune analyse des enregistrements
+    const LevelPackHeader *header = map;
+    size_t size = (size_t)st.st_size;
+    if (memcmp(header->magic, LEVELPACK_MAGIC, sizeof(header->magic)) != 0 ||
+        header->version != LEVELPACK_VERSION ||
+        header->recordSize != sizeof(LevelRecord) ||
+        header->numLevels != LEVELPACK_NUM_LEVELS ||
+        header->recordsOffset > size ||
+        (size - header->recordsOffset) / sizeof(LevelRecord) < header->numRecords) {
+        munmap(map, size);
+        return false;
+    }
+    for (int level = 0; level < LEVELPACK_NUM_LEVELS; level++) {
+        const LevelIndexEntry *entry = &header->index[level];
+        if ((uint64_t)entry->first + entry->count > header->numRecords) {
+            munmap(map, size);
+            return false;
+        }
+    }
+
+    pack->map = map;
+    pack->size = size;
+    pack->header = header;
+    pack->records = (const LevelRecord *)((const char *)map + header->recordsOffset);
+    return true;
+}
+
+void levelPackClose(LevelPack *pack) {
+    if (pack->map) munmap(pack->map, pack->size);
+    memset(pack, 0, sizeof(*pack));
+}
+
+const LevelRecord *levelPackPick(const LevelPack *pack, DifficultyLevel level, uint32_t random) {
+    if (!pack->map || level < 0 || level >= LEVELPACK_NUM_LEVELS) return NULL;
+    const LevelIndexEntry *entry = &pack->header->index[level];
+    if (entry->count == 0) return NULL;
+    return &pack->records[entry->first + random % entry->count];
+}
+
+bool levelRecordToGame(const LevelRecord *record, GameState *game) {
+    game->numPiles = record->numPiles;
+    game->maxTokens = record->maxTokens;
+    game->numColors = record->numColors;
+    game->seed = record->seed;
+
+    // Les enregistrements ne sont pas vérifiés à l'ouverture : un fichier abîmé ne doit pas
+    // faire lire au-delà de record->board ni écrire au-delà de codes
+    PackShape shape;
+    if (game->numPiles == 0 || game->maxTokens == 0 || game->numColors == 0 ||
+        !packShapeInit(&shape, game) || shape.words > LEVELPACK_BOARD_WORDS) {
+        return false;
+    }
+    PileCode codes[MAX_PILES];
+    unpackBoard(&shape, record->board, codes);
+    for (int i = 0; i < MAX_PILES; i++) {
+        game->piles[i].count = 0;
+    }
+    packToGame(&shape, codes, game);
+    return true;
+}
+
+bool levelRecordFromGame(LevelRecord *record, const GameState *game, DifficultyLevel level, int optimalMoves) {
+    PackShape shape;
+    if (!packShapeInit(&shape, game) || shape.words > LEVELPACK_BOARD_WORDS || optimalMoves > UINT8_MAX) {
+        return false;
+    }
+    memset(record, 0, sizeof(*record));
+    PileCode codes[MAX_PILES];
+    packFromGame(&shape, game, codes);
+    packBoard(&shape, codes, record->board);
+    record->seed = game->seed;
+    record->level = (uint8_t)level;
+    record->numPiles = (uint8_t)game->numPiles;
+    record->maxTokens = (uint8_t)game->maxTokens;
+    record->numColors = (uint8_t)game->numColors;
+    record->optimalMoves = (uint8_t)optimalMoves;
+    return true;
+}
+
+static int compareRecords(const void *a, const void *b) {
+    const LevelRecord *ra = a, *rb = b;
+    if (ra->level != rb->level) return ra->level - rb->level;
+    if (ra->optimalMoves != rb->optimalMoves) return ra->optimalMoves - rb->optimalMoves;
+    return (ra->seed > rb->seed) - (ra->seed < rb->seed);
+}
+
+bool levelPackWrite(const char *path, LevelRecord *records, uint32_t numRecords) {
+    qsort(records, numRecords, sizeof(LevelRecord), compareRecords);
+
+    LevelPackHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, LEVELPACK_MAGIC, sizeof(header.magic));
+    header.version = LEVELPACK_VERSION;
+    header.recordSize = sizeof(LevelRecord);
+    header.numRecords = numRecords;
+    header.numLevels = LEVELPACK_NUM_LEVELS;
+    // Enregistrements alignés sur 64 octets
+    header.recordsOffset = (sizeof(header) + 63) & ~(uint64_t)63;
+
+    for (uint32_t i = 0; i < numRecords; i++) {
+        LevelIndexEntry *entry = &header.index[records[i].level];
+        if (entry->count == 0) entry->first = i;
+        entry->count++;
+    }
+
+    FILE *file = fopen(path, "wb");
+    if (!file) return false;
+    static const char padding[64] = {0};
+    size_t paddingSize = header.recordsOffset - sizeof(header);
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+              fwrite(padding, 1, paddingSize, file) == paddingSize &&
+              fwrite(records, sizeof(LevelRecord), numRecords, file) == numRecords;
+    return fclose(file) == 0 && ok;
+}
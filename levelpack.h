@@ -0,0 +1,69 @@
+#ifndef LEVELPACK_H
+#define LEVELPACK_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "game.h"
+
+// Fichier de niveaux pré-générés, projeté en mémoire (mmap) et lu sans analyse :
+//   en-tête | index par difficulté | enregistrements de taille fixe
+// Les entiers sont stockés en petit-boutiste (ordre natif des machines visées).
+#define LEVELPACK_MAGIC "NUTSPACK"
+#define LEVELPACK_VERSION 1
+#define LEVELPACK_NUM_LEVELS (LEVEL_HARD + 1)
+#define LEVELPACK_BOARD_WORDS 2
+#define LEVELPACK_DEFAULT_PATH "levels.pack"
+
+typedef struct {
+    uint32_t first;     // Premier enregistrement de ce niveau
+    uint32_t count;
+} LevelIndexEntry;
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t recordSize;
+    uint32_t numRecords;
+    uint32_t numLevels;
+    uint64_t recordsOffset;
+    LevelIndexEntry index[LEVELPACK_NUM_LEVELS];
+} LevelPackHeader;
+
+// Enregistrements triés par niveau puis par nombre de coups optimal
+typedef struct {
+    uint64_t board[LEVELPACK_BOARD_WORDS];   // Plateau compact (boardpack), non canonique
+    uint64_t seed;                           // Graine du générateur
+    uint8_t level;
+    uint8_t numPiles;
+    uint8_t maxTokens;
+    uint8_t numColors;
+    uint8_t optimalMoves;
+    uint8_t reserved[3];
+} LevelRecord;
+
+typedef struct {
+    void *map;
+    size_t size;
+    const LevelPackHeader *header;
+    const LevelRecord *records;
+} LevelPack;
+
+bool levelPackOpen(LevelPack *pack, const char *path);
+void levelPackClose(LevelPack *pack);
+
+// Choix en O(1) d'un niveau de difficulté donnée (random choisit l'enregistrement) ;
+// NULL si le fichier n'en contient pas
+const LevelRecord *levelPackPick(const LevelPack *pack, DifficultyLevel level, uint32_t random);
+
+// Remplit les piles et les dimensions de game à partir d'un enregistrement ; false (game
+// à réinitialiser) si ses dimensions sont hors des limites PACK_MAX_* du plateau compact
+bool levelRecordToGame(const LevelRecord *record, GameState *game);
+
+// Encode game (déjà évalué) dans un enregistrement ; false si le plateau est trop grand
+bool levelRecordFromGame(LevelRecord *record, const GameState *game, DifficultyLevel level, int optimalMoves);
+
+// Trie les enregistrements, construit l'index et écrit le fichier
+bool levelPackWrite(const char *path, LevelRecord *records, uint32_t numRecords);
+
+#endif
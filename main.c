@@ -3,48 +3,68 @@
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
 #include <math.h>
+#include "game.h"
+#include "generator.h"
+#include "levelpack.h"
+#include "textcache.h"
+#include "glyphatlas.h"
+#include "batch.h"
+#include "raster.h"
+#include "profiler.h"
+#include "animation.h"
+#include "movelog.h"
+#include "replay.h"
+#include "hint.h"
+#ifdef RENDER_BENCH
+#include "renderstats.h"
+#include "solver.h"
+#endif
 
 #define WINDOW_WIDTH 900
 #define WINDOW_HEIGHT 700
-#define MAX_PILES 12
-#define MAX_TOKENS 6
 
+// Dimensions de base des piles et des jetons (celles des sprites) ; les grands plateaux les
+// réduisent pour tenir dans la fenêtre (voir computeLayout)
+#define PILE_WIDTH 80
+#define PILE_HEIGHT 350
+#define PILE_SPACING 30
+#define TOKEN_INSET 5                   // Entre le bord de la pile et les jetons
+#define TOKEN_WIDTH (PILE_WIDTH - 2 * TOKEN_INSET)
+#define TOKEN_HEIGHT 50
+#define TOKEN_SPACING 10
+#define BOARD_TOP 120
+#define BOARD_BOTTOM (WINDOW_HEIGHT - 90)   // Au-dessus des boutons
+#define BOARD_MARGIN 20
+#define ZOOM_STEP 1.25f
+#define SCROLL_STEP 120                 // Défilement par touche fléchée (px)
+#define CORNER_RADIUS 10
+#define SELECTION_THICKNESS 3
+#define MAX_BUTTON_SKINS 8
+#define ATLAS_PADDING 2
+#define MENU_BUTTONS 4
 
+// Cadence du rendu à la demande (ms)
+#define BACKGROUND_FRAME_INTERVAL 100   // Fenêtre sans le focus
+#define IDLE_TIMEOUT 1000               // Attente maximale sans rien à afficher
+#define DEFAULT_REFRESH_RATE 60         // Si l'écran ne donne pas sa fréquence
 
-typedef enum {
-    LEVEL_NONE,
-    LEVEL_EASY,
-    LEVEL_MEDIUM,
-    LEVEL_HARD
-} DifficultyLevel;
+// Simulation à pas fixe, indépendante de la fréquence d'affichage
+#define SIMULATION_RATE 240             // Pas par seconde
+#define MAX_SIMULATION_LAG 250          // Retard rattrapé au plus (ms), au-delà il est abandonné
+#define ANIMATION_DURATION 500          // ms
+#define CATCH_UP_DURATION 150           // Reste au plus aux animations dépassées par un coup (ms)
 
-typedef enum {
-    GAME_PLAYING,
-    GAME_WON
-} GameStatus;
+// Clics en attente, traités dans l'ordre une fois les évènements de l'image lus
+#define INPUT_QUEUE_SIZE 32             // Puissance de deux
 
-typedef struct {
-    int colors[MAX_TOKENS];
-    int count;
-} Pile;
 
-typedef struct {
-    Pile piles[MAX_PILES];
-    int numPiles;
-    int maxTokens;
-    int numColors;
-    int selected;
-    GameStatus status;
-    DifficultyLevel currentLevel;
-    int moveCount;
-    Uint32 startTime;
-    Uint32 endTime;  // Ajouter cette ligne pour stocker le temps de fin
-} GameState;
-
-// Palette de couleurs attrayante pour les jetons
-SDL_Color COLORS[6] = {
+
+// Palette de couleurs attrayante pour les jetons ; les couleurs au-delà de la sixième sont
+// générées par initPalette
+SDL_Color COLORS[MAX_COLORS] = {
     {231, 76, 60, 255},   // Rouge-corail
     {46, 204, 113, 255},  // Vert-émeraude
     {52, 152, 219, 255},  // Bleu-ciel
@@ -69,70 +89,305 @@ typedef struct {
     void* data;
 } Button;
 
-// Structure pour les effets d'animation
+// Jetons en mouvement (voir animation.h), initialisé dans main
+AnimationPool animations;
+
+// Coups de la partie en cours, pour annuler / rejouer (voir movelog.h)
+MoveLog moveLog;
+
+// Enregistrement de la partie en cours (voir replay.h), écrit dans replayPath quand elle se
+// termine ; NULL : pas d'enregistrement. La relecture (--replay) rejoue playback en temps réel.
+Replay replay;
+bool recording = false;
+const char *replayPath = REPLAY_DEFAULT_PATH;
+Replay playback;
+bool playing = false;
+uint32_t playbackNext = 0;
+
+// Indice calculé en arrière-plan (voir hint.h) : hintFrom -> hintTo est surligné jusqu'au
+// prochain coup ; hintMissing : la recherche n'a rien trouvé
+HintEngine hints;
+bool hintWaiting = false;
+bool hintMissing = false;
+int hintFrom = -1;
+int hintTo = -1;
+
+typedef struct {
+    int x[INPUT_QUEUE_SIZE];
+    int y[INPUT_QUEUE_SIZE];
+    unsigned head;
+    unsigned tail;
+} InputQueue;
+
+InputQueue clickQueue = {{0}, {0}, 0, 0};
+
+// Fraction du pas de simulation écoulée depuis le dernier pas, dans [0, 1)
+float simulationAlpha = 0.0f;
+
+// Formes pré-rendues une fois dans des textures : chaque image ne fait plus que des copies.
+// Jetons, cadre de pile et contour de sélection partagent un atlas, ce qui permet de
+// dessiner tout le plateau en un seul lot (voir batch.h). Les skins de boutons sont créés à
+// la demande pour chaque taille rencontrée.
 typedef struct {
-    bool active;
-    int sourceX;
-    int sourceY;
-    int destX;
-    int destY;
-    int colorIndex;
-    float progress;
-    Uint32 startTime;
-} TokenAnimation;
-
-TokenAnimation currentAnimation = {false};
+    int w;
+    int h;
+    SDL_Texture *normal;
+    SDL_Texture *hover;
+} ButtonSkin;
+
+typedef struct {
+    bool ready;             // false : rendu direct (pas de textures cibles)
+    SDL_Texture *atlas;
+    SDL_Rect tokens[MAX_COLORS];
+    SDL_Rect pile;
+    SDL_Rect selection;     // Contour doré seul, posé sur le cadre de la pile
+    ButtonSkin buttons[MAX_BUTTON_SKINS];
+    int numButtons;
+} SpriteCache;
+
+SpriteCache sprites = {false};
+SpriteBatch boardBatch = {0};
+
+// Couche statique de l'écran de jeu, rendue dans une texture (voir renderStaticLayer) ;
+// invalidée à chaque reconstruction de la disposition (voir screenLayout)
+typedef struct {
+    SDL_Texture *texture;
+    bool valid;
+} StaticLayer;
+
+StaticLayer staticLayer = {NULL, false};
+
+// Mode logiciel (--software, ou renderer de la fenêtre non accéléré) : les formes sont
+// rastérisées par spans (raster.h) dans une image de l'écran en mémoire, envoyée une seule
+// fois par image dans une texture de streaming. Un renderer logiciel SDL branché sur la même
+// image y dessine le texte : tout le rendu lui est passé à la place de celui de la fenêtre.
+typedef struct {
+    bool enabled;
+    SDL_Renderer *window;       // Renderer de la fenêtre : une copie par image
+    SDL_Texture *texture;       // Streaming, WINDOW_WIDTH x WINDOW_HEIGHT
+    SDL_Surface *surface;       // Image de l'écran (ARGB8888)
+    SDL_Renderer *renderer;     // Renderer logiciel qui écrit dans surface
+    Canvas canvas;              // Pixels de surface
+    Canvas staticLayer;         // Couche statique, recopiée à chaque image
+} SoftwareFrame;
+
+SoftwareFrame software = {false};
+
+// Vue du plateau : le zoom n'agrandit que les plateaux réduits pour tenir dans la fenêtre
+typedef struct {
+    float zoom;     // 1 : tout le plateau est visible
+    int scroll;     // Décalage horizontal (px) quand le plateau dépasse la fenêtre
+} BoardView;
+
+BoardView boardView = {1.0f, 0};
+
+// Disposition du plateau pour la forme du niveau et la vue courantes. Les dimensions de base
+// sont réduites séparément en largeur et en hauteur pour tenir dans la fenêtre, puis le zoom
+// rend de la largeur ; seules les piles [firstVisible, endVisible) sont dessinées.
+typedef struct {
+    int pileWidth;
+    int pileHeight;
+    int pitch;              // Écart entre les bords gauches de deux piles voisines
+    int tokenInset;
+    int tokenWidth;
+    int tokenHeight;
+    int tokenStep;          // Écart vertical entre deux jetons voisins
+    int startX;             // Bord gauche de la pile 0, défilement compris
+    int startY;
+    int boardWidth;
+    int firstVisible;
+    int endVisible;
+} BoardLayout;
+
+// Boutons de l'écran de jeu et de l'écran de victoire
+typedef enum {
+    GAME_RESTART,
+    GAME_MENU,
+    GAME_UNDO,
+    GAME_REDO,
+    GAME_HINT,
+    GAME_QUIT,
+    GAME_BUTTONS
+} GameButtonId;
+
+typedef enum {
+    WIN_RESTART,
+    WIN_MENU,
+    WIN_QUIT,
+    WIN_BUTTONS
+} WinButtonId;
+
+// Tout ce qui a une position à l'écran pendant une partie : plateau, rectangle de chaque pile,
+// hauteur de chaque rang de jetons et boutons. Reconstruite seulement quand le niveau, la forme,
+// la vue ou la taille de la fenêtre change (voir screenLayout) ; le rendu, les clics, les
+// animations et le banc la partagent.
+typedef struct {
+    bool valid;
+    GameState *game;        // Donnée des boutons
+    DifficultyLevel level;
+    int numPiles;
+    int maxTokens;
+    BoardView view;
+    BoardLayout board;
+    SDL_Rect piles[MAX_PILES];
+    int slotY[MAX_TOKENS];  // Haut du jeton de rang r (0 : en bas de la pile)
+    Button gameButtons[GAME_BUTTONS];
+    Button winButtons[WIN_BUTTONS];
+} ScreenLayout;
+
+ScreenLayout screen = {false};
+
+// Dernière position du pointeur en coordonnées logiques (survol des boutons)
+int pointerX = -1;
+int pointerY = -1;
+
+// Profileur : F3 affiche p50/p99 du temps d'image, F4 écrit la trace (voir profiler.h)
+#define TRACE_DEFAULT_PATH "nuts-trace.json"
+bool showProfiler = false;
+
+// Niveaux pré-générés (make levels), projetés en mémoire au démarrage s'ils existent
+LevelPack levelPack;
+
+// Glyphes pré-rendus (make glyphs), projetés en mémoire au démarrage s'ils existent
+GlyphAtlas glyphAtlas;
 
 void initGame(GameState *game, DifficultyLevel level);
+ScreenLayout *screenLayout(GameState *game);
+void drawToken(SDL_Renderer *renderer, int x, int y, int width, int height, SDL_Color color);
+
+
+// Écrit la partie enregistrée s'il y a eu au moins un coup
+void saveReplay(void) {
+    if (!recording || !replayPath || replay.numMoves == 0) return;
+    if (!replayWrite(&replay, replayPath)) {
+        printf("Impossible d'écrire la partie dans %s\n", replayPath);
+    }
+    replay.numMoves = 0;
+}
 
+void recordMove(const GameState *game, int from, int to) {
+    if (recording) replayRecord(&replay, SDL_GetTicks() - game->startTime, from, to);
+}
 
 void actionQuit(void *data) {
     (void)data; // Pour éviter l'avertissement de variable non utilisée
+    saveReplay();
     exit(0);
 }
 
-void renderText(SDL_Renderer *renderer, TTF_Font *font, const char *text, int x, int y, SDL_Color color) {
-    SDL_Surface *surface = TTF_RenderText_Blended(font, text, color);
-    if (!surface) {
-        printf("Erreur de rendu du texte: %s\n", TTF_GetError());
-        return;
-    }
-    
-    SDL_Texture *texture = SDL_CreateTextureFromSurface(renderer, surface);
-    if (!texture) {
-        printf("Erreur de création de texture: %s\n", SDL_GetError());
-        SDL_FreeSurface(surface);
-        return;
+// Polices de l'interface : rien n'est ouvert ici, SDL_ttf ne sert qu'aux caractères qui
+// manquent à l'atlas (ou à tous s'il n'y a pas d'atlas)
+void initFonts(TextFont *font, TextFont *largeFont) {
+    const GlyphAtlas *atlas = NULL;
+    if (glyphAtlasOpen(&glyphAtlas, GLYPH_ATLAS_DEFAULT_PATH)) {
+        atlas = &glyphAtlas;
+        printf("Glyphes chargés depuis %s\n", GLYPH_ATLAS_DEFAULT_PATH);
     }
-    
-    SDL_Rect dst = {x, y, surface->w, surface->h};
-    SDL_RenderCopy(renderer, texture, NULL, &dst);
-    SDL_FreeSurface(surface);
-    SDL_DestroyTexture(texture);
+    textFontInit(font, atlas, UI_FONT_PATH, UI_FONT_SIZE, GLYPH_STYLE_REGULAR);
+    textFontInit(largeFont, atlas, UI_BOLD_FONT_PATH, UI_LARGE_FONT_SIZE, GLYPH_STYLE_BOLD);
 }
 
-void renderTextCentered(SDL_Renderer *renderer, TTF_Font *font, const char *text, int x, int y, SDL_Color color) {
-    SDL_Surface *surface = TTF_RenderText_Blended(font, text, color);
-    if (!surface) {
-        printf("Erreur de rendu du texte: %s\n", TTF_GetError());
-        return;
+void closeFonts(TextFont *font, TextFont *largeFont) {
+    textFontClose(font);
+    textFontClose(largeFont);
+    glyphAtlasClose(&glyphAtlas);
+}
+
+void renderText(SDL_Renderer *renderer, TextFont *font, const char *text, int x, int y, SDL_Color color) {
+    textCacheDraw(renderer, font, text, x, y, color, false);
+}
+
+void renderTextCentered(SDL_Renderer *renderer, TextFont *font, const char *text, int x, int y, SDL_Color color) {
+    textCacheDraw(renderer, font, text, x, y, color, true);
+}
+
+// Image où rastériser si le rendu en cours va à l'écran en mode logiciel ; le texte déjà
+// demandé à SDL y est d'abord écrit pour garder l'ordre de dessin
+Canvas *softwareCanvas(SDL_Renderer *renderer) {
+    if (!software.enabled || renderer != software.renderer || SDL_GetRenderTarget(renderer)) return NULL;
+    SDL_RenderFlush(renderer);
+    return &software.canvas;
+}
+
+// Couleur de dessin du renderer, au format du rastériseur
+uint32_t drawColor(SDL_Renderer *renderer) {
+    Uint8 r, g, b, a;
+    SDL_GetRenderDrawColor(renderer, &r, &g, &b, &a);
+    return rasterColor(r, g, b, a);
+}
+
+// Rectangle plein à la couleur de dessin
+void fillRect(SDL_Renderer *renderer, const SDL_Rect *rect) {
+    Canvas *canvas = softwareCanvas(renderer);
+    if (canvas) rasterFillRect(canvas, rect->x, rect->y, rect->w, rect->h, drawColor(renderer));
+    else SDL_RenderFillRect(renderer, rect);
+}
+
+void softwareFree(void) {
+    if (software.texture) SDL_DestroyTexture(software.texture);
+    if (software.renderer) SDL_DestroyRenderer(software.renderer);
+    if (software.surface) SDL_FreeSurface(software.surface);
+    canvasFree(&software.staticLayer);
+    memset(&software, 0, sizeof(software));
+}
+
+// Texture de streaming du renderer de la fenêtre ; à recréer après une perte du périphérique
+bool softwareCreateTexture(void) {
+    if (software.texture) SDL_DestroyTexture(software.texture);
+    software.texture = SDL_CreateTexture(software.window, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING,
+                                         WINDOW_WIDTH, WINDOW_HEIGHT);
+    if (!software.texture) printf("Erreur de création de la texture de l'écran: %s\n", SDL_GetError());
+    return software.texture != NULL;
+}
+
+// Crée l'image de l'écran et son renderer logiciel ; retourne le renderer à utiliser pour tout
+// le rendu, ou NULL (le mode logiciel reste désactivé)
+SDL_Renderer *softwareInit(SDL_Renderer *window) {
+    memset(&software, 0, sizeof(software));
+    software.window = window;
+    software.surface = SDL_CreateRGBSurfaceWithFormat(0, WINDOW_WIDTH, WINDOW_HEIGHT, 32, SDL_PIXELFORMAT_ARGB8888);
+    software.renderer = software.surface ? SDL_CreateSoftwareRenderer(software.surface) : NULL;
+    if (!software.renderer || !softwareCreateTexture() || !canvasAlloc(&software.staticLayer, WINDOW_WIDTH, WINDOW_HEIGHT)) {
+        printf("Erreur d'initialisation du rendu logiciel: %s\n", SDL_GetError());
+        softwareFree();
+        return NULL;
     }
-    
-    SDL_Texture *texture = SDL_CreateTextureFromSurface(renderer, surface);
-    if (!texture) {
-        printf("Erreur de création de texture: %s\n", SDL_GetError());
-        SDL_FreeSurface(surface);
+    software.canvas = (Canvas){software.surface->pixels, software.surface->w, software.surface->h,
+                               software.surface->pitch / (int)sizeof(uint32_t)};
+    SDL_SetRenderDrawBlendMode(software.renderer, SDL_BLENDMODE_BLEND);
+    software.enabled = true;
+    return software.renderer;
+}
+
+// Fenêtre où s'affiche le rendu (le renderer logiciel n'en a pas)
+SDL_Window *renderWindow(SDL_Renderer *renderer) {
+    return SDL_RenderGetWindow(software.enabled ? software.window : renderer);
+}
+
+// Fin d'image ; en mode logiciel, l'image de l'écran est envoyée puis copiée dans la fenêtre
+void presentFrame(SDL_Renderer *renderer) {
+    if (!software.enabled || renderer != software.renderer) {
+        SDL_RenderPresent(renderer);
         return;
     }
-    
-    SDL_Rect dst = {x - surface->w / 2, y - surface->h / 2, surface->w, surface->h};
-    SDL_RenderCopy(renderer, texture, NULL, &dst);
-    SDL_FreeSurface(surface);
-    SDL_DestroyTexture(texture);
+    if (!software.texture) return;      // Perdue avec le périphérique et non recréée
+    SDL_RenderFlush(renderer);
+    SDL_UpdateTexture(software.texture, NULL, software.surface->pixels, software.surface->pitch);
+    SDL_SetRenderDrawColor(software.window, 0, 0, 0, 255);
+    SDL_RenderClear(software.window);
+    SDL_RenderCopy(software.window, software.texture, NULL, NULL);
+    SDL_RenderPresent(software.window);
 }
 
 // Dessiner un rectangle avec des coins arrondis
 void drawRoundedRect(SDL_Renderer *renderer, int x, int y, int w, int h, int radius) {
+    // Le tracé SDL couvre jusqu'à x + w et y + h inclus
+    Canvas *canvas = softwareCanvas(renderer);
+    if (canvas) {
+        rasterStrokeRoundedRect(canvas, x, y, w + 1, h + 1, radius, 1, drawColor(renderer));
+        return;
+    }
+
     // Les quatre coins
     for (int i = 0; i <= radius; ++i) {
         double angle = i * M_PI / (2 * radius);
@@ -152,6 +407,12 @@ void drawRoundedRect(SDL_Renderer *renderer, int x, int y, int w, int h, int rad
 
 // Remplir un rectangle avec des coins arrondis
 void fillRoundedRect(SDL_Renderer *renderer, int x, int y, int w, int h, int radius) {
+    Canvas *canvas = softwareCanvas(renderer);
+    if (canvas) {
+        rasterFillRoundedRect(canvas, x, y, w + 1, h + 1, radius, drawColor(renderer));
+        return;
+    }
+
     SDL_Rect rect = {x + radius, y, w - 2 * radius, h};
     SDL_RenderFillRect(renderer, &rect);
     
@@ -204,11 +465,11 @@ void fillRoundedRect(SDL_Renderer *renderer, int x, int y, int w, int h, int rad
     }
 }
 
-void renderButton(SDL_Renderer *renderer, TTF_Font *font, Button *button) {
-    SDL_Color color = button->hover ? BUTTON_HOVER_COLOR : BUTTON_COLOR;
+void drawButtonShape(SDL_Renderer *renderer, int x, int y, int w, int h, bool hover) {
+    SDL_Color color = hover ? BUTTON_HOVER_COLOR : BUTTON_COLOR;
     
     SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
-    fillRoundedRect(renderer, button->rect.x, button->rect.y, button->rect.w, button->rect.h, 10);
+    fillRoundedRect(renderer, x, y, w, h, CORNER_RADIUS);
     
     // Bordure du bouton
     SDL_SetRenderDrawColor(renderer, 
@@ -216,7 +477,318 @@ void renderButton(SDL_Renderer *renderer, TTF_Font *font, Button *button) {
                           (color.g + TEXT_COLOR.g) / 2, 
                           (color.b + TEXT_COLOR.b) / 2, 
                           255);
-    drawRoundedRect(renderer, button->rect.x, button->rect.y, button->rect.w, button->rect.h, 10);
+    drawRoundedRect(renderer, x, y, w, h, CORNER_RADIUS);
+}
+
+void drawPileShape(SDL_Renderer *renderer, int x, int y, int w, int h) {
+    // Fond de la pile avec une légère transparence
+    SDL_SetRenderDrawColor(renderer, 30, 40, 50, 180);
+    fillRoundedRect(renderer, x, y, w, h, CORNER_RADIUS);
+
+    // Pile normale - contour subtil
+    SDL_SetRenderDrawColor(renderer, PILE_BORDER_COLOR.r, PILE_BORDER_COLOR.g, PILE_BORDER_COLOR.b, 180);
+    drawRoundedRect(renderer, x, y, w, h, CORNER_RADIUS);
+}
+
+// Pile sélectionnée - contour doré plus épais et arrondi, recouvre le contour normal
+void drawSelectionShape(SDL_Renderer *renderer, int x, int y, int w, int h) {
+    SDL_SetRenderDrawColor(renderer, SELECTED_COLOR.r, SELECTED_COLOR.g, SELECTED_COLOR.b, SELECTED_COLOR.a);
+    for (int t = 0; t < SELECTION_THICKNESS; t++) {
+        drawRoundedRect(renderer, x - t, y - t, w + 2*t, h + 2*t, CORNER_RADIUS);
+    }
+}
+
+// Teinte en degrés, saturation et valeur dans [0, 1]
+SDL_Color hsvColor(float hue, float saturation, float value) {
+    float c = value * saturation;
+    float h = hue / 60.0f;
+    float x = c * (1.0f - fabsf(fmodf(h, 2.0f) - 1.0f));
+    float r = 0, g = 0, b = 0;
+    switch ((int)h % 6) {
+        case 0: r = c; g = x; break;
+        case 1: r = x; g = c; break;
+        case 2: g = c; b = x; break;
+        case 3: g = x; b = c; break;
+        case 4: r = x; b = c; break;
+        default: r = c; b = x;
+    }
+    float m = value - c;
+    SDL_Color color = {(Uint8)((r + m) * 255), (Uint8)((g + m) * 255), (Uint8)((b + m) * 255), 255};
+    return color;
+}
+
+// Couleurs des grands plateaux : teintes espacées de l'angle d'or, en alternant la saturation
+// et la luminosité pour que les voisines restent distinctes
+void initPalette(void) {
+    for (int c = 6; c < MAX_COLORS; c++) {
+        float hue = fmodf(c * 137.508f, 360.0f);
+        float saturation = (c / 2) % 2 ? 0.55f : 0.8f;
+        float value = c % 2 ? 0.65f : 0.9f;
+        COLORS[c] = hsvColor(hue, saturation, value);
+    }
+}
+
+// Crée une texture cible transparente de w x h et y redirige le rendu
+SDL_Texture *beginSprite(SDL_Renderer *renderer, int w, int h) {
+    SDL_Texture *texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, w, h);
+    if (!texture) {
+        printf("Erreur de création de sprite: %s\n", SDL_GetError());
+        return NULL;
+    }
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderTarget(renderer, texture);
+    // Écrire l'alpha tel quel : le mélange se fera lors de la copie à l'écran
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+    SDL_RenderClear(renderer);
+    return texture;
+}
+
+void endSprite(SDL_Renderer *renderer) {
+    SDL_SetRenderTarget(renderer, NULL);
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+}
+
+void freeSprites(void) {
+    if (sprites.atlas) SDL_DestroyTexture(sprites.atlas);
+    for (int i = 0; i < sprites.numButtons; i++) {
+        if (sprites.buttons[i].normal) SDL_DestroyTexture(sprites.buttons[i].normal);
+        if (sprites.buttons[i].hover) SDL_DestroyTexture(sprites.buttons[i].hover);
+    }
+    memset(&sprites, 0, sizeof(sprites));
+}
+
+SDL_Texture *buttonSkin(SDL_Renderer *renderer, int w, int h, bool hover);
+
+// (Re)crée les sprites ; à rappeler si le pilote perd le contenu des textures cibles
+void bakeSprites(SDL_Renderer *renderer) {
+    freeSprites();
+    // En mode logiciel, jetons et cadres sont rastérisés à chaque image : des remplissages
+    // opaques par lignes plutôt que des copies de sprites mélangées pixel par pixel
+    if (software.enabled) return;
+    if (!SDL_RenderTargetSupported(renderer)) {
+        printf("Textures cibles non supportées : rendu direct des formes\n");
+        return;
+    }
+
+    // Disposition de l'atlas : cadre de pile, contour de sélection, puis des colonnes de jetons.
+    // drawRoundedRect trace jusqu'à x + w inclus, et le contour sélectionné déborde vers
+    // l'extérieur ; ATLAS_PADDING évite que les régions voisines se touchent.
+    int margin = SELECTION_THICKNESS - 1;
+    sprites.pile = (SDL_Rect){0, 0, PILE_WIDTH + 1, PILE_HEIGHT + 1};
+    sprites.selection = (SDL_Rect){sprites.pile.w + ATLAS_PADDING, 0,
+                                   PILE_WIDTH + 1 + 2*margin, PILE_HEIGHT + 1 + 2*margin};
+    int tokenX = sprites.selection.x + sprites.selection.w + ATLAS_PADDING;
+    int perColumn = sprites.selection.h / (TOKEN_HEIGHT + ATLAS_PADDING);
+    int columns = (MAX_COLORS + perColumn - 1) / perColumn;
+    for (int c = 0; c < MAX_COLORS; c++) {
+        sprites.tokens[c] = (SDL_Rect){tokenX + c / perColumn * (TOKEN_WIDTH + ATLAS_PADDING),
+                                       c % perColumn * (TOKEN_HEIGHT + ATLAS_PADDING), TOKEN_WIDTH, TOKEN_HEIGHT};
+    }
+    int atlasWidth = tokenX + columns * (TOKEN_WIDTH + ATLAS_PADDING);
+    int atlasHeight = sprites.selection.h;
+
+    sprites.atlas = beginSprite(renderer, atlasWidth, atlasHeight);
+    if (sprites.atlas) {
+        drawPileShape(renderer, sprites.pile.x, sprites.pile.y, PILE_WIDTH, PILE_HEIGHT);
+        drawSelectionShape(renderer, sprites.selection.x + margin, sprites.selection.y + margin, PILE_WIDTH, PILE_HEIGHT);
+        for (int c = 0; c < MAX_COLORS; c++) {
+            drawToken(renderer, sprites.tokens[c].x, sprites.tokens[c].y,
+                      sprites.tokens[c].w, sprites.tokens[c].h, COLORS[c]);
+        }
+    }
+    endSprite(renderer);
+    sprites.ready = sprites.atlas != NULL;
+
+    // Tailles des boutons du menu, du jeu et de l'écran de victoire : éviter de changer de
+    // cible au milieu d'une image
+    buttonSkin(renderer, 200, 60, false);
+    buttonSkin(renderer, 150, 50, false);
+    buttonSkin(renderer, 110, 50, false);
+    buttonSkin(renderer, 160, 60, false);
+}
+
+SDL_Texture *buttonSkin(SDL_Renderer *renderer, int w, int h, bool hover) {
+    ButtonSkin *skin = NULL;
+    for (int i = 0; i < sprites.numButtons; i++) {
+        if (sprites.buttons[i].w == w && sprites.buttons[i].h == h) skin = &sprites.buttons[i];
+    }
+    if (!skin) {
+        if (sprites.numButtons == MAX_BUTTON_SKINS) return NULL;
+        skin = &sprites.buttons[sprites.numButtons++];
+        skin->w = w;
+        skin->h = h;
+        skin->normal = beginSprite(renderer, w + 1, h + 1);
+        if (skin->normal) drawButtonShape(renderer, 0, 0, w, h, false);
+        skin->hover = beginSprite(renderer, w + 1, h + 1);
+        if (skin->hover) drawButtonShape(renderer, 0, 0, w, h, true);
+        endSprite(renderer);
+    }
+    return hover ? skin->hover : skin->normal;
+}
+
+void copySprite(SDL_Renderer *renderer, SDL_Texture *texture, int x, int y) {
+    SDL_Rect dst = {x, y, 0, 0};
+    SDL_QueryTexture(texture, NULL, NULL, &dst.w, &dst.h);
+    SDL_RenderCopy(renderer, texture, NULL, &dst);
+}
+
+// Les formes du plateau sont accumulées dans boardBatch entre beginBoard et endBoard
+void beginBoard(void) {
+    if (sprites.ready) batchBegin(&boardBatch, sprites.atlas);
+}
+
+void endBoard(SDL_Renderer *renderer) {
+    if (sprites.ready) batchFlush(&boardBatch, renderer);
+}
+
+// Région de l'atlas étirée en w x h
+void batchSprite(SDL_Renderer *renderer, const SDL_Rect *region, int x, int y, int w, int h) {
+    SDL_Rect dst = {x, y, w, h};
+    if (!batchQuad(&boardBatch, region, &dst)) {
+        // Lot plein faute de mémoire : dessiner d'abord ce qu'il contient pour garder l'ordre
+        batchFlush(&boardBatch, renderer);
+        if (!batchQuad(&boardBatch, region, &dst)) SDL_RenderCopy(renderer, sprites.atlas, region, &dst);
+    }
+}
+
+// Comme batchSprite, en neuf morceaux : les coins (border px) ne sont pas déformés, les
+// bords et le centre sont étirés
+void batchFrame(SDL_Renderer *renderer, const SDL_Rect *region, int border, int x, int y, int w, int h) {
+    if (w == region->w && h == region->h) {
+        batchSprite(renderer, region, x, y, w, h);
+        return;
+    }
+    int borderX = 2 * border > w ? w / 2 : border;
+    int borderY = 2 * border > h ? h / 2 : border;
+    int srcX[4] = {region->x, region->x + border, region->x + region->w - border, region->x + region->w};
+    int srcY[4] = {region->y, region->y + border, region->y + region->h - border, region->y + region->h};
+    int dstX[4] = {x, x + borderX, x + w - borderX, x + w};
+    int dstY[4] = {y, y + borderY, y + h - borderY, y + h};
+    for (int row = 0; row < 3; row++) {
+        for (int col = 0; col < 3; col++) {
+            if (dstX[col + 1] == dstX[col] || dstY[row + 1] == dstY[row]) continue;
+            SDL_Rect src = {srcX[col], srcY[row], srcX[col + 1] - srcX[col], srcY[row + 1] - srcY[row]};
+            batchSprite(renderer, &src, dstX[col], dstY[row], dstX[col + 1] - dstX[col], dstY[row + 1] - dstY[row]);
+        }
+    }
+}
+
+void renderToken(SDL_Renderer *renderer, const BoardLayout *layout, int x, int y, int colorIndex) {
+    if (sprites.ready) {
+        batchSprite(renderer, &sprites.tokens[colorIndex], x, y, layout->tokenWidth, layout->tokenHeight);
+    } else {
+        drawToken(renderer, x, y, layout->tokenWidth, layout->tokenHeight, COLORS[colorIndex]);
+    }
+}
+
+void renderPile(SDL_Renderer *renderer, const BoardLayout *layout, int x, int y) {
+    if (sprites.ready) {
+        batchFrame(renderer, &sprites.pile, CORNER_RADIUS + 1, x, y, layout->pileWidth + 1, layout->pileHeight + 1);
+    } else {
+        drawPileShape(renderer, x, y, layout->pileWidth, layout->pileHeight);
+    }
+}
+
+void renderSelection(SDL_Renderer *renderer, const BoardLayout *layout, int x, int y) {
+    if (sprites.ready) {
+        int margin = SELECTION_THICKNESS - 1;
+        batchFrame(renderer, &sprites.selection, CORNER_RADIUS + 1 + margin, x - margin, y - margin,
+                   layout->pileWidth + 1 + 2*margin, layout->pileHeight + 1 + 2*margin);
+    } else {
+        drawSelectionShape(renderer, x, y, layout->pileWidth, layout->pileHeight);
+    }
+}
+
+// Largeur du plateau aux dimensions de base
+int baseBoardWidth(const GameState *game) {
+    return game->numPiles * (PILE_WIDTH + PILE_SPACING) - PILE_SPACING;
+}
+
+void computeLayout(const GameState *game, BoardLayout *layout) {
+    int baseHeight = game->maxTokens * (TOKEN_HEIGHT + TOKEN_SPACING) + TOKEN_SPACING;
+    if (baseHeight < PILE_HEIGHT) baseHeight = PILE_HEIGHT;
+    int visibleWidth = WINDOW_WIDTH - 2 * BOARD_MARGIN;
+    float scaleX = fminf(1.0f, fminf(1.0f, (float)visibleWidth / baseBoardWidth(game)) * boardView.zoom);
+    float scaleY = fminf(1.0f, (float)(BOARD_BOTTOM - BOARD_TOP) / baseHeight);
+
+    int spacing = (int)lroundf(PILE_SPACING * scaleX);
+    layout->pileWidth = (int)fmaxf(2.0f, lroundf(PILE_WIDTH * scaleX));
+    layout->pileHeight = (int)lroundf(baseHeight * scaleY);
+    layout->pitch = layout->pileWidth + spacing;
+    layout->tokenInset = (int)lroundf(TOKEN_INSET * scaleX);
+    layout->tokenWidth = layout->pileWidth - 2 * layout->tokenInset;
+    layout->tokenHeight = (int)fmaxf(1.0f, lroundf(TOKEN_HEIGHT * scaleY));
+    layout->tokenStep = (int)lroundf((TOKEN_HEIGHT + TOKEN_SPACING) * scaleY);
+    layout->boardWidth = game->numPiles * layout->pitch - spacing;
+    layout->startY = BOARD_TOP;
+
+    // Centré s'il tient dans la fenêtre, sinon décalé du défilement (borné au plateau)
+    if (layout->boardWidth <= visibleWidth) {
+        layout->startX = (WINDOW_WIDTH - layout->boardWidth) / 2;
+    } else {
+        int scroll = boardView.scroll;
+        if (scroll > layout->boardWidth - visibleWidth) scroll = layout->boardWidth - visibleWidth;
+        if (scroll < 0) scroll = 0;
+        layout->startX = BOARD_MARGIN - scroll;
+    }
+
+    // Piles dont une partie est dans la fenêtre
+    int hidden = -layout->startX - layout->pileWidth;
+    layout->firstVisible = hidden < 0 ? 0 : hidden / layout->pitch + 1;
+    layout->endVisible = (WINDOW_WIDTH - layout->startX + layout->pitch - 1) / layout->pitch;
+    if (layout->endVisible > game->numPiles) layout->endVisible = game->numPiles;
+}
+
+// Applique un zoom et un défilement, bornés au plateau. Si la vue change, la disposition (et
+// avec elle la couche statique) est à refaire et les jetons en route sont posés à leur arrivée
+// plutôt que de viser leur ancienne position à l'écran.
+void setBoardView(const GameState *game, float zoom, int scroll) {
+    int visibleWidth = WINDOW_WIDTH - 2 * BOARD_MARGIN;
+    float maxZoom = fmaxf(1.0f, (float)baseBoardWidth(game) / visibleWidth);
+    BoardView previous = boardView;
+    boardView.zoom = fminf(maxZoom, fmaxf(1.0f, zoom));
+
+    BoardLayout layout;
+    computeLayout(game, &layout);
+    int maxScroll = layout.boardWidth - visibleWidth;
+    if (scroll > maxScroll) scroll = maxScroll;
+    if (scroll < 0) scroll = 0;
+    boardView.scroll = scroll;
+
+    if (boardView.zoom == previous.zoom && boardView.scroll == previous.scroll) return;
+    animClear(&animations);
+}
+
+void scrollBoard(const GameState *game, int scroll) {
+    setBoardView(game, boardView.zoom, scroll);
+}
+
+// Multiplie le zoom par factor en gardant le centre de la fenêtre au même endroit du plateau ;
+// au plus le zoom qui rend aux piles leur taille de base
+void zoomBoard(const GameState *game, float factor) {
+    int visibleWidth = WINDOW_WIDTH - 2 * BOARD_MARGIN;
+    BoardLayout layout;
+    computeLayout(game, &layout);
+    float center = (BOARD_MARGIN - layout.startX + visibleWidth / 2.0f) / layout.boardWidth;
+
+    setBoardView(game, boardView.zoom * factor, boardView.scroll);
+    computeLayout(game, &layout);
+    scrollBoard(game, (int)lroundf(center * layout.boardWidth - visibleWidth / 2.0f));
+}
+
+void resetBoardView(void) {
+    boardView.zoom = 1.0f;
+    boardView.scroll = 0;
+}
+
+void renderButton(SDL_Renderer *renderer, TextFont *font, Button *button) {
+    SDL_Texture *skin = sprites.ready ? buttonSkin(renderer, button->rect.w, button->rect.h, button->hover) : NULL;
+    if (skin) {
+        copySprite(renderer, skin, button->rect.x, button->rect.y);
+    } else {
+        drawButtonShape(renderer, button->rect.x, button->rect.y, button->rect.w, button->rect.h, button->hover);
+    }
     
     // Texte centré
     renderTextCentered(renderer, font, button->text, 
@@ -225,7 +797,7 @@ void renderButton(SDL_Renderer *renderer, TTF_Font *font, Button *button) {
                      TEXT_COLOR);
 }
 
-bool isPointInRect(int x, int y, SDL_Rect *rect) {
+bool isPointInRect(int x, int y, const SDL_Rect *rect) {
     return (x >= rect->x && x <= rect->x + rect->w &&
             y >= rect->y && y <= rect->y + rect->h);
 }
@@ -257,32 +829,182 @@ void actionBackToMenu(void *data) {
     GameState *game = (GameState *)data;
     game->status = GAME_PLAYING;
     game->currentLevel = LEVEL_NONE;  // Retour au menu principal
+    saveReplay();
+}
+
+// Anime le jeton qui vient de passer du haut de la pile from au haut de la pile to
+void animateMove(GameState *game, int from, int to) {
+    const ScreenLayout *layout = screenLayout(game);
+    Pile *src = &game->piles[from];
+    Pile *dest = &game->piles[to];
+
+    int srcTokenX = layout->piles[from].x + layout->board.tokenInset;
+    int srcTokenY = layout->slotY[src->count];
+    int destTokenX = layout->piles[to].x + layout->board.tokenInset;
+    int destTokenY = layout->slotY[dest->count - 1];
+
+    // Les jetons encore en route se pressent pour ne pas prendre de retard
+    animHurry(&animations, CATCH_UP_DURATION);
+    animMove(&animations, from, src->count, srcTokenX, srcTokenY,
+             to, dest->count - 1, destTokenX, destTokenY, dest->colors[dest->count - 1], ANIMATION_DURATION);
+}
+
+// Oublie l'indice affiché ou en cours de calcul : à appeler dès que le plateau change
+void clearHint(void) {
+    hintCancel(&hints);
+    hintWaiting = false;
+    hintMissing = false;
+    hintFrom = -1;
+    hintTo = -1;
+}
+
+// Lance la recherche sur le plateau courant ; le rendu continue pendant ce temps
+void actionHint(void *data) {
+    GameState *game = (GameState *)data;
+    if (game->status != GAME_PLAYING || hintWaiting) return;
+    clearHint();
+    hintRequest(&hints, game);
+    hintWaiting = hints.started;
+}
+
+// Relève la boîte aux lettres du moteur d'indices ; retourne true si l'affichage change
+bool updateHint(void) {
+    int from, to;
+    if (!hintWaiting) return false;
+    HintStatus status = hintPoll(&hints, &from, &to);
+    if (status == HINT_PENDING) return false;
+    hintWaiting = false;
+    hintMissing = status == HINT_NONE;
+    if (status == HINT_FOUND) {
+        hintFrom = from;
+        hintTo = to;
+    }
+    return true;
 }
 
-DifficultyLevel showLevelMenu(SDL_Renderer *renderer, TTF_Font *font, TTF_Font *titleFont) {
+// Appelé par le thread de recherche : réveille SDL_WaitEventTimeout
+void wakeMainLoop(void) {
     SDL_Event event;
-    DifficultyLevel selected = LEVEL_NONE;
-    Button buttons[4] = {
+    SDL_zero(event);
+    event.type = SDL_USEREVENT;
+    SDL_PushEvent(&event);
+}
+
+// Annuler / rejouer : le coup est rejoué à l'envers (ou à l'endroit) et compté
+void actionUndo(void *data) {
+    GameState *game = (GameState *)data;
+    MoveRecord move;
+    if (game->status != GAME_PLAYING || !moveLogUndo(&moveLog, game, &move)) return;
+    clearHint();
+    animateMove(game, move.to, move.from);
+    recordMove(game, move.to, move.from);
+    game->moveCount--;
+    game->selected = -1;
+}
+
+void actionRedo(void *data) {
+    GameState *game = (GameState *)data;
+    MoveRecord move;
+    if (game->status != GAME_PLAYING || !moveLogRedo(&moveLog, game, &move)) return;
+    clearHint();
+    animateMove(game, move.from, move.to);
+    recordMove(game, move.from, move.to);
+    game->moveCount++;
+    game->selected = -1;
+    if (checkWin(game)) {
+        game->status = GAME_WON;
+        game->endTime = SDL_GetTicks();
+    }
+}
+
+// Disposition courante de l'écran de jeu, reconstruite si ce dont elle dépend a changé
+ScreenLayout *screenLayout(GameState *game) {
+    if (screen.valid && screen.game == game && screen.level == game->currentLevel &&
+        screen.numPiles == game->numPiles && screen.maxTokens == game->maxTokens &&
+        screen.view.zoom == boardView.zoom && screen.view.scroll == boardView.scroll) {
+        return &screen;
+    }
+
+    BoardLayout *board = &screen.board;
+    computeLayout(game, board);
+    for (int i = 0; i < game->numPiles; i++) {
+        screen.piles[i] = (SDL_Rect){board->startX + i * board->pitch, board->startY,
+                                     board->pileWidth, board->pileHeight};
+    }
+    for (int r = 0; r < game->maxTokens; r++) {
+        screen.slotY[r] = board->startY + board->pileHeight - (r + 1) * board->tokenStep;
+    }
+
+    Button gameButtons[GAME_BUTTONS] = {
+        [GAME_RESTART] = {{20, WINDOW_HEIGHT - 70, 150, 50}, "Restart", false, actionRestart, game},
+        [GAME_MENU] = {{190, WINDOW_HEIGHT - 70, 150, 50}, "Main Menu", false, actionBackToMenu, game},
+        [GAME_UNDO] = {{360, WINDOW_HEIGHT - 70, 110, 50}, "Undo", false, actionUndo, game},
+        [GAME_REDO] = {{480, WINDOW_HEIGHT - 70, 110, 50}, "Redo", false, actionRedo, game},
+        [GAME_HINT] = {{600, WINDOW_HEIGHT - 70, 110, 50}, "Hint", false, actionHint, game},
+        [GAME_QUIT] = {{WINDOW_WIDTH - 170, WINDOW_HEIGHT - 70, 150, 50}, "Quit", false, actionQuit, NULL},
+    };
+    Button winButtons[WIN_BUTTONS] = {
+        [WIN_RESTART] = {{WINDOW_WIDTH / 2 - 270, WINDOW_HEIGHT / 2 + 100, 160, 60}, "Play Again", false,
+                         actionRestart, game},
+        [WIN_MENU] = {{WINDOW_WIDTH / 2 - 80, WINDOW_HEIGHT / 2 + 100, 160, 60}, "Main Menu", false,
+                      actionBackToMenu, game},
+        [WIN_QUIT] = {{WINDOW_WIDTH / 2 + 110, WINDOW_HEIGHT / 2 + 100, 160, 60}, "Quit", false, actionQuit, NULL},
+    };
+    memcpy(screen.gameButtons, gameButtons, sizeof(gameButtons));
+    memcpy(screen.winButtons, winButtons, sizeof(winButtons));
+
+    screen.valid = true;
+    screen.game = game;
+    screen.level = game->currentLevel;
+    screen.numPiles = game->numPiles;
+    screen.maxTokens = game->maxTokens;
+    screen.view = boardView;
+    staticLayer.valid = false;
+    return &screen;
+}
+
+// Pile sous le point, -1 s'il n'y en a pas : les piles sont des colonnes régulières, une
+// division suffit
+int hitPile(const ScreenLayout *layout, int x, int y) {
+    const BoardLayout *board = &layout->board;
+    if (y < board->startY || y > board->startY + board->pileHeight) return -1;
+    int dx = x - board->startX;
+    if (dx < 0) return -1;
+    int pile = dx / board->pitch;
+    if (pile >= layout->numPiles || dx - pile * board->pitch > board->pileWidth) return -1;
+    return pile;
+}
+
+// Indice du bouton sous le point, -1 s'il n'y en a pas
+int hitButton(const Button *buttons, int count, int x, int y) {
+    for (int i = 0; i < count; i++) {
+        if (isPointInRect(x, y, &buttons[i].rect)) return i;
+    }
+    return -1;
+}
+
+void initMenuButtons(Button buttons[MENU_BUTTONS], DifficultyLevel *selected) {
+    Button menu[MENU_BUTTONS] = {
         {
             {WINDOW_WIDTH / 2 - 100, 250, 200, 60},
             "Easy",
             false,
             actionPlayEasy,
-            &selected
+            selected
         },
         {
             {WINDOW_WIDTH / 2 - 100, 330, 200, 60},
             "Medium",
             false,
             actionPlayMedium,
-            &selected
+            selected
         },
         {
             {WINDOW_WIDTH / 2 - 100, 410, 200, 60},
             "Hard",
             false,
             actionPlayHard,
-            &selected
+            selected
         },
         {
             {WINDOW_WIDTH / 2 - 100, 490, 200, 60},
@@ -292,7 +1014,10 @@ DifficultyLevel showLevelMenu(SDL_Renderer *renderer, TTF_Font *font, TTF_Font *
             NULL
         }
     };
+    memcpy(buttons, menu, sizeof(menu));
+}
 
+SDL_Texture *createMenuBackground(SDL_Renderer *renderer) {
     // Créer un dégradé d'arrière-plan
     SDL_Surface *background = SDL_CreateRGBSurface(0, WINDOW_WIDTH, WINDOW_HEIGHT, 32, 0, 0, 0, 0);
     for (int y = 0; y < WINDOW_HEIGHT; ++y) {
@@ -307,55 +1032,88 @@ DifficultyLevel showLevelMenu(SDL_Renderer *renderer, TTF_Font *font, TTF_Font *
     }
     SDL_Texture *bgTexture = SDL_CreateTextureFromSurface(renderer, background);
     SDL_FreeSurface(background);
+    return bgTexture;
+}
+
+void renderLevelMenu(SDL_Renderer *renderer, TextFont *font, TextFont *titleFont, SDL_Texture *bgTexture, Button *buttons) {
+    // Afficher l'arrière-plan
+    SDL_RenderCopy(renderer, bgTexture, NULL, NULL);
+    
+    // Titre stylisé
+    renderTextCentered(renderer, titleFont, "NUTS PUZZLE", WINDOW_WIDTH / 2, 100, TEXT_COLOR);
+    renderTextCentered(renderer, font, "Select Difficulty", WINDOW_WIDTH / 2, 160, TEXT_COLOR);
+    
+    // Afficher les descriptions de niveau sous chaque bouton
+    /*renderTextCentered(renderer, font, "(4 piles, 3 couleurs, max 3 jetons)", 
+                      WINDOW_WIDTH / 2, buttons[0].rect.y + buttons[0].rect.h + 20, TEXT_COLOR);
+    
+    renderTextCentered(renderer, font, "(6 piles, 4 couleurs, max 4 jetons)", 
+                      WINDOW_WIDTH / 2, buttons[1].rect.y + buttons[1].rect.h + 20, TEXT_COLOR);
+    
+    renderTextCentered(renderer, font, "(8 piles, 5 couleurs, max 5 jetons)", 
+                      WINDOW_WIDTH / 2, buttons[2].rect.y + buttons[2].rect.h + 20, TEXT_COLOR);*/
+    
+    // Dessiner les boutons
+    for (int i = 0; i < MENU_BUTTONS; i++) {
+        renderButton(renderer, font, &buttons[i]);
+    }
+
+    presentFrame(renderer);
+}
+
+DifficultyLevel showLevelMenu(SDL_Renderer *renderer, TextFont *font, TextFont *titleFont) {
+    SDL_Event event;
+    DifficultyLevel selected = LEVEL_NONE;
+    Button buttons[MENU_BUTTONS];
+    initMenuButtons(buttons, &selected);
+
+    SDL_Texture *bgTexture = createMenuBackground(renderer);
 
+    // Le menu est immobile : ne redessiner que si un survol change ou si la fenêtre est exposée
+    bool dirty = true;
     while (selected == LEVEL_NONE) {
-        while (SDL_PollEvent(&event)) {
+        if (!dirty && !SDL_WaitEventTimeout(&event, IDLE_TIMEOUT)) continue;
+        if (dirty && !SDL_PollEvent(&event)) event.type = 0;
+
+        do {
             if (event.type == SDL_QUIT) {
                 SDL_DestroyTexture(bgTexture);
                 exit(0);
+            } else if (event.type == SDL_WINDOWEVENT) {
+                dirty = true;
+            } else if (event.type == SDL_RENDER_TARGETS_RESET || event.type == SDL_RENDER_DEVICE_RESET) {
+                bakeSprites(renderer);
+                if (event.type == SDL_RENDER_DEVICE_RESET) {
+                    textCacheFlush();
+                    if (software.enabled) softwareCreateTexture();
+                }
+                dirty = true;
             } else if (event.type == SDL_MOUSEMOTION) {
                 int x = event.motion.x;
                 int y = event.motion.y;
                 
-                for (int i = 0; i < 4; i++) {
-                    buttons[i].hover = isPointInRect(x, y, &buttons[i].rect);
+                for (int i = 0; i < MENU_BUTTONS; i++) {
+                    bool hover = isPointInRect(x, y, &buttons[i].rect);
+                    if (hover != buttons[i].hover) dirty = true;
+                    buttons[i].hover = hover;
                 }
             } else if (event.type == SDL_MOUSEBUTTONDOWN) {
                 int x = event.button.x;
                 int y = event.button.y;
                 
-                for (int i = 0; i < 4; i++) {
+                for (int i = 0; i < MENU_BUTTONS; i++) {
                     if (isPointInRect(x, y, &buttons[i].rect)) {
                         buttons[i].action(buttons[i].data);
                     }
                 }
             }
-        }
+        } while (SDL_PollEvent(&event));
 
-        // Afficher l'arrière-plan
-        SDL_RenderCopy(renderer, bgTexture, NULL, NULL);
-        
-        // Titre stylisé
-        renderTextCentered(renderer, titleFont, "NUTS PUZZLE", WINDOW_WIDTH / 2, 100, TEXT_COLOR);
-        renderTextCentered(renderer, font, "Select Difficulty", WINDOW_WIDTH / 2, 160, TEXT_COLOR);
-        
-        // Afficher les descriptions de niveau sous chaque bouton
-        /*renderTextCentered(renderer, font, "(4 piles, 3 couleurs, max 3 jetons)", 
-                          WINDOW_WIDTH / 2, buttons[0].rect.y + buttons[0].rect.h + 20, TEXT_COLOR);
-        
-        renderTextCentered(renderer, font, "(6 piles, 4 couleurs, max 4 jetons)", 
-                          WINDOW_WIDTH / 2, buttons[1].rect.y + buttons[1].rect.h + 20, TEXT_COLOR);
-        
-        renderTextCentered(renderer, font, "(8 piles, 5 couleurs, max 5 jetons)", 
-                          WINDOW_WIDTH / 2, buttons[2].rect.y + buttons[2].rect.h + 20, TEXT_COLOR);*/
-        
-        // Dessiner les boutons
-        for (int i = 0; i < 4; i++) {
-            renderButton(renderer, font, &buttons[i]);
-        }
+        if (!dirty || selected != LEVEL_NONE) continue;
+        dirty = false;
+        if (SDL_GetWindowFlags(renderWindow(renderer)) & SDL_WINDOW_MINIMIZED) continue;
 
-        SDL_RenderPresent(renderer);
-        SDL_Delay(16);
+        renderLevelMenu(renderer, font, titleFont, bgTexture, buttons);
     }
     
     SDL_DestroyTexture(bgTexture);
@@ -370,83 +1128,30 @@ void initGame(GameState *game, DifficultyLevel level) {
     game->moveCount = 0;
     game->startTime = SDL_GetTicks();
     game->endTime = 0;  // Initialiser le temps de fin à 0
-    currentAnimation.active = false;
+    animClear(&animations);
+    moveLogClear(&moveLog);
+    clearHint();
+    resetBoardView();
+    saveReplay();
+    playing = false;
 
-    // Réinitialiser toutes les piles
-    for (int i = 0; i < MAX_PILES; i++) {
-        game->piles[i].count = 0;
-        for (int j = 0; j < MAX_TOKENS; j++) {
-            game->piles[i].colors[j] = 0;
-        }
-    }
-
-    switch (level) {
-        case LEVEL_EASY:
-            game->numColors = 3;
-            game->numPiles = 4;
-            game->maxTokens = 3;
-            break;
-        case LEVEL_MEDIUM:
-            game->numColors = 4;
-            game->numPiles = 6;
-            game->maxTokens = 4;
-            break;
-        case LEVEL_HARD:
-            game->numColors = 5;
-            game->numPiles = 8;
-            game->maxTokens = 5;
-            break;
-        default:
-            game->numColors = 3;
-            game->numPiles = 4;
-            game->maxTokens = 3;
-    }
-
-    int colorCounts[6] = {0};
-    int total = game->numColors * game->maxTokens;
-    srand(time(NULL));
-
-    // S'assurer que chaque couleur est utilisée exactement maxTokens fois
-    for (int i = 0; i < total;) {
-        int color = rand() % game->numColors;
-        if (colorCounts[color] < game->maxTokens) {
-            int pileIndex;
-            do {
-                pileIndex = rand() % game->numPiles;
-            } while (game->piles[pileIndex].count >= game->maxTokens);
-            game->piles[pileIndex].colors[game->piles[pileIndex].count++] = color;
-            colorCounts[color]++;
-            i++;
-        }
+    // Piocher dans le fichier de niveaux si possible, sinon mélanger un plateau résolu
+    // (temps borné, reproductible par la graine)
+    setLevelShape(game, level);
+    const LevelRecord *record = levelPackPick(&levelPack, level, (uint32_t)(rngNext() >> 32));
+    if (!record || !levelRecordToGame(record, game)) {
+        setLevelShape(game, level);     // Un enregistrement refusé a pu changer les dimensions
+        game->seed = rngNext();
+        generateBoard(game, game->seed, defaultScrambleMoves(game));
     }
-}
-
-bool checkWin(GameState *game) {
-    // Une pile est triée si tous les jetons sont de la même couleur
-    for (int i = 0; i < game->numPiles; i++) {
-        if (game->piles[i].count > 0) {
-            int firstColor = game->piles[i].colors[0];
-            for (int j = 1; j < game->piles[i].count; j++) {
-                if (game->piles[i].colors[j] != firstColor) {
-                    return false;
-                }
-            }
-            
-            // Si la pile n'est pas complète (maxTokens jetons) avec la même couleur
-            if (game->piles[i].count != game->maxTokens && game->piles[i].count != 0) {
-                return false;
-            }
-        }
-    }
-    
-    return true;
+    recording = replayBegin(&replay, game);
 }
 
 void drawToken(SDL_Renderer *renderer, int x, int y, int width, int height, SDL_Color color) {
     // Jeton principal
     SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
     SDL_Rect mainToken = {x, y, width, height};
-    SDL_RenderFillRect(renderer, &mainToken);
+    fillRect(renderer, &mainToken);
     
     // Highlight (haut et gauche)
     SDL_SetRenderDrawColor(renderer, 
@@ -456,11 +1161,11 @@ void drawToken(SDL_Renderer *renderer, int x, int y, int width, int height, SDL_
                           color.a);
     
     SDL_Rect highlight = {x, y, width, 5};
-    SDL_RenderFillRect(renderer, &highlight);
+    fillRect(renderer, &highlight);
     
     highlight.h = height;
     highlight.w = 5;
-    SDL_RenderFillRect(renderer, &highlight);
+    fillRect(renderer, &highlight);
     
     // Ombre (bas et droite)
     SDL_SetRenderDrawColor(renderer, 
@@ -470,49 +1175,59 @@ void drawToken(SDL_Renderer *renderer, int x, int y, int width, int height, SDL_
                           color.a);
     
     SDL_Rect shadow = {x, y + height - 5, width, 5};
-    SDL_RenderFillRect(renderer, &shadow);
+    fillRect(renderer, &shadow);
     
     shadow.x = x + width - 5;
     shadow.y = y;
     shadow.w = 5;
     shadow.h = height;
-    SDL_RenderFillRect(renderer, &shadow);
+    fillRect(renderer, &shadow);
     
     // Bordure du jeton
     SDL_SetRenderDrawColor(renderer, 50, 50, 50, 255);
-    SDL_RenderDrawRect(renderer, &mainToken);
+    Canvas *canvas = softwareCanvas(renderer);
+    if (canvas) rasterStrokeRoundedRect(canvas, x, y, width, height, 0, 1, drawColor(renderer));
+    else SDL_RenderDrawRect(renderer, &mainToken);
 }
 
-void startTokenAnimation(int srcX, int srcY, int destX, int destY, int colorIndex) {
-    currentAnimation.active = true;
-    currentAnimation.sourceX = srcX;
-    currentAnimation.sourceY = srcY;
-    currentAnimation.destX = destX;
-    currentAnimation.destY = destY;
-    currentAnimation.colorIndex = colorIndex;
-    currentAnimation.progress = 0.0f;
-    currentAnimation.startTime = SDL_GetTicks();
+// Retourne false (clic perdu) si la file est pleine
+bool queueClick(int x, int y) {
+    if (clickQueue.tail - clickQueue.head == INPUT_QUEUE_SIZE) return false;
+    clickQueue.x[clickQueue.tail & (INPUT_QUEUE_SIZE - 1)] = x;
+    clickQueue.y[clickQueue.tail & (INPUT_QUEUE_SIZE - 1)] = y;
+    clickQueue.tail++;
+    return true;
 }
 
-void updateAnimation() {
-    if (!currentAnimation.active) return;
-    
-    Uint32 currentTime = SDL_GetTicks();
-    float elapsed = (currentTime - currentAnimation.startTime) / 500.0f; // Animation dure 500ms
-    
-    currentAnimation.progress = elapsed;
-    
-    if (currentAnimation.progress >= 1.0f) {
-        currentAnimation.active = false;
+bool nextClick(int *x, int *y) {
+    if (clickQueue.head == clickQueue.tail) return false;
+    *x = clickQueue.x[clickQueue.head & (INPUT_QUEUE_SIZE - 1)];
+    *y = clickQueue.y[clickQueue.head & (INPUT_QUEUE_SIZE - 1)];
+    clickQueue.head++;
+    return true;
+}
+
+// Un pas de simulation de 1/SIMULATION_RATE s
+void updateAnimation(void) {
+    animStep(&animations, 1000.0f / SIMULATION_RATE);
+}
+
+// Fréquence de l'écran qui affiche la fenêtre (Hz)
+int displayRefreshRate(SDL_Window *window) {
+    SDL_DisplayMode mode;
+    int display = SDL_GetWindowDisplayIndex(window);
+    if (display < 0 || SDL_GetCurrentDisplayMode(display, &mode) != 0 || mode.refresh_rate <= 0) {
+        return DEFAULT_REFRESH_RATE;
     }
+    return mode.refresh_rate;
 }
 
-void renderWinScreen(SDL_Renderer *renderer, TTF_Font *font, TTF_Font *largeFont, GameState *game) {
+void renderWinScreen(SDL_Renderer *renderer, TextFont *font, TextFont *largeFont, GameState *game) {
     // Superposition semi-transparente
     SDL_SetRenderDrawColor(renderer, 0, 0, 0, 180);
     SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
     SDL_Rect overlay = {0, 0, WINDOW_WIDTH, WINDOW_HEIGHT};
-    SDL_RenderFillRect(renderer, &overlay);
+    fillRect(renderer, &overlay);
     
     // Temps écoulé (utiliser le temps écoulé jusqu'à la victoire)
     Uint32 elapsedTime = game->endTime - game->startTime;
@@ -532,47 +1247,28 @@ void renderWinScreen(SDL_Renderer *renderer, TTF_Font *font, TTF_Font *largeFont
     sprintf(statsText, "Moves: %d   Time: %02d:%02d", game->moveCount, minutes, seconds);
     renderTextCentered(renderer, font, statsText, WINDOW_WIDTH / 2, WINDOW_HEIGHT / 2 + 10, TEXT_COLOR);
     
-    // Définir les boutons de manière simple
-    Button restartButton = {
-        {WINDOW_WIDTH / 2 - 270, WINDOW_HEIGHT / 2 + 100, 160, 60},
-        "Play Again",
-        false,
-        actionRestart,
-        game
-    };
-    
-    Button menuButton = {
-        {WINDOW_WIDTH / 2 - 80, WINDOW_HEIGHT / 2 + 100, 160, 60},
-        "Main Menu",
-        false,
-        actionBackToMenu,
-        game
-    };
-    
-    Button quitButton = {
-        {WINDOW_WIDTH / 2 + 110, WINDOW_HEIGHT / 2 + 100, 160, 60},
-        "Quit",
-        false,
-        actionQuit,
-        NULL
-    };
-    
-    // Vérifier si la souris survole les boutons
-    int mouseX, mouseY;
-    SDL_GetMouseState(&mouseX, &mouseY);
-    restartButton.hover = isPointInRect(mouseX, mouseY, &restartButton.rect);
-    menuButton.hover = isPointInRect(mouseX, mouseY, &menuButton.rect);
-    quitButton.hover = isPointInRect(mouseX, mouseY, &quitButton.rect);
-    
-    // Rendre les boutons de façon simplifiée
-    renderButton(renderer, font, &restartButton);
-    renderButton(renderer, font, &menuButton);
-    renderButton(renderer, font, &quitButton);
+    // Boutons de la disposition partagée avec handleClick
+    Button *buttons = screenLayout(game)->winButtons;
+    int hover = hitButton(buttons, WIN_BUTTONS, pointerX, pointerY);
+    for (int b = 0; b < WIN_BUTTONS; b++) {
+        buttons[b].hover = b == hover;
+        renderButton(renderer, font, &buttons[b]);
+    }
 }
 
-void renderGame(SDL_Renderer *renderer, GameState *game, TTF_Font *font, TTF_Font *largeFont) {
+// Partie de l'écran de jeu qui ne change pas pendant une partie : dégradé, en-tête,
+// textes fixes et cadres des piles
+void drawStaticLayer(SDL_Renderer *renderer, GameState *game, TextFont *font, TextFont *largeFont) {
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+
     // Arrière-plan avec dégradé
-    for (int y = 0; y < WINDOW_HEIGHT; ++y) {
+    Canvas *canvas = softwareCanvas(renderer);
+    if (canvas) {
+        SDL_Color c = BACKGROUND_COLOR;
+        rasterGradient(canvas, 0, 0, WINDOW_WIDTH, WINDOW_HEIGHT, rasterColor(c.r, c.g, c.b, 255),
+                       rasterColor(c.r * 0.8, c.g * 0.8, c.b * 0.8, 255));
+    }
+    for (int y = 0; !canvas && y < WINDOW_HEIGHT; ++y) {
         float factor = (float)y / WINDOW_HEIGHT;
         SDL_SetRenderDrawColor(renderer, 
                               BACKGROUND_COLOR.r * (1.0 - factor*0.2),
@@ -585,19 +1281,84 @@ void renderGame(SDL_Renderer *renderer, GameState *game, TTF_Font *font, TTF_Fon
     // En-tête avec infos de niveau
     SDL_SetRenderDrawColor(renderer, 52, 73, 94, 240);
     SDL_Rect headerRect = {0, 0, WINDOW_WIDTH, 80};
-    SDL_RenderFillRect(renderer, &headerRect);
+    fillRect(renderer, &headerRect);
     
     // Afficher le niveau actuel
     char levelText[20];
     sprintf(levelText, "%s", 
             game->currentLevel == LEVEL_EASY ? "EASY" : 
-            game->currentLevel == LEVEL_MEDIUM ? "MEDIUM" : "HARD");
+            game->currentLevel == LEVEL_MEDIUM ? "MEDIUM" :
+            game->currentLevel == LEVEL_HARD ? "HARD" : "CUSTOM");
     renderText(renderer, largeFont, levelText, 30, 20, TEXT_COLOR);
     
     // Instructions
     renderTextCentered(renderer, font, "Sort tokens by color", WINDOW_WIDTH / 2, 40, TEXT_COLOR);
+
+    // Cadres des piles vides (celles qui sont à l'écran)
+    const ScreenLayout *layout = screenLayout(game);
+    beginBoard();
+    for (int i = layout->board.firstVisible; i < layout->board.endVisible; i++) {
+        renderPile(renderer, &layout->board, layout->piles[i].x, layout->piles[i].y);
+    }
+    endBoard(renderer);
+}
+
+// Copie la couche statique, reconstruite seulement quand la disposition change
+void renderStaticLayer(SDL_Renderer *renderer, GameState *game, TextFont *font, TextFont *largeFont) {
+    screenLayout(game);
+    // Mode logiciel : une copie de la couche gardée en mémoire
+    Canvas *canvas = softwareCanvas(renderer);
+    if (canvas) {
+        if (staticLayer.valid) {
+            canvasCopy(canvas, &software.staticLayer);
+        } else {
+            drawStaticLayer(renderer, game, font, largeFont);
+            canvasCopy(&software.staticLayer, softwareCanvas(renderer));
+            staticLayer.valid = true;
+        }
+        return;
+    }
+    if (!staticLayer.texture && sprites.ready) {
+        staticLayer.texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET,
+                                                WINDOW_WIDTH, WINDOW_HEIGHT);
+        // Opaque : la copie remplace l'écran sans mélange
+        if (staticLayer.texture) SDL_SetTextureBlendMode(staticLayer.texture, SDL_BLENDMODE_NONE);
+        staticLayer.valid = false;
+    }
+    if (!staticLayer.texture) {
+        drawStaticLayer(renderer, game, font, largeFont);
+        return;
+    }
+
+    if (!staticLayer.valid) {
+        SDL_SetRenderTarget(renderer, staticLayer.texture);
+        drawStaticLayer(renderer, game, font, largeFont);
+        SDL_SetRenderTarget(renderer, NULL);
+        staticLayer.valid = true;
+    }
+    SDL_RenderCopy(renderer, staticLayer.texture, NULL, NULL);
+}
+
+void renderProfilerOverlay(SDL_Renderer *renderer, TextFont *font) {
+    FrameStats stats = profilerFrameStats();
+    char text[64];
+    snprintf(text, sizeof(text), "p50 %.2f ms  p99 %.2f ms  (%d)", stats.p50, stats.p99, stats.frames);
+
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 160);
+    SDL_Rect box = {10, 85, 360, 32};
+    fillRect(renderer, &box);
+    renderText(renderer, font, text, 18, 88, SELECTED_COLOR);
+}
+
+void renderGame(SDL_Renderer *renderer, GameState *game, TextFont *font, TextFont *largeFont) {
+    // Couche statique, puis jetons, animation et HUD par-dessus
+    uint64_t stage = profileBegin();
+    renderStaticLayer(renderer, game, font, largeFont);
+    profileEnd("background", stage);
     
     // Afficher le compteur de mouvements
+    stage = profileBegin();
     char moveText[20];
     sprintf(moveText, "Moves: %d", game->moveCount);
     renderText(renderer, font, moveText, WINDOW_WIDTH - 150, 20, TEXT_COLOR);
@@ -617,278 +1378,486 @@ void renderGame(SDL_Renderer *renderer, GameState *game, TTF_Font *font, TTF_Fon
     sprintf(timeText, "Time: %02d:%02d", minutes, seconds);
     renderText(renderer, font, timeText, WINDOW_WIDTH - 150, 50, TEXT_COLOR);
 
-    int pileWidth = 80;
-    int pileHeight = 350;
-    int pileSpacing = 30;
-    int startX = (WINDOW_WIDTH - (game->numPiles * (pileWidth + pileSpacing) - pileSpacing)) / 2;
-    int startY = 120;
-    int tokenHeight = 50;
-    int tokenSpacing = 10;
+    // Indice : piles numérotées à partir de 1, comme on les compte à l'écran
+    if (hintFrom >= 0) {
+        char hintText[40];
+        sprintf(hintText, "Hint: %d -> %d", hintFrom + 1, hintTo + 1);
+        renderTextCentered(renderer, font, hintText, WINDOW_WIDTH / 2, 100, TEXT_COLOR);
+    } else if (hintMissing) {
+        renderTextCentered(renderer, font, "No hint found", WINDOW_WIDTH / 2, 100, TEXT_COLOR);
+    }
+    profileEnd("hud", stage);
+
+    stage = profileBegin();
+    ScreenLayout *layout = screenLayout(game);
+    const BoardLayout *board = &layout->board;
 
-    // Dessiner les piles
-    for (int i = 0; i < game->numPiles; i++) {
-        SDL_Rect rect = {startX + i * (pileWidth + pileSpacing), startY, pileWidth, pileHeight};
+    // Dessiner les piles à l'écran : contour de sélection et jetons en un seul lot
+    beginBoard();
+    for (int i = board->firstVisible; i < board->endVisible; i++) {
+        int x = layout->piles[i].x;
         
-        // Fond de la pile avec une légère transparence
-        SDL_SetRenderDrawColor(renderer, 30, 40, 50, 180);
-        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-        fillRoundedRect(renderer, rect.x, rect.y, rect.w, rect.h, 10);
-        
-        // Pile sélectionnée - contour doré
-        if (i == game->selected) {
-            SDL_SetRenderDrawColor(renderer, SELECTED_COLOR.r, SELECTED_COLOR.g, SELECTED_COLOR.b, SELECTED_COLOR.a);
-            // Dessiner un contour plus épais et arrondi
-            for (int t = 0; t < 3; t++) {
-                drawRoundedRect(renderer, rect.x - t, rect.y - t, rect.w + 2*t, rect.h + 2*t, 10);
-            }
-        } else {
-            // Pile normale - contour subtil
-            SDL_SetRenderDrawColor(renderer, PILE_BORDER_COLOR.r, PILE_BORDER_COLOR.g, PILE_BORDER_COLOR.b, 180);
-            drawRoundedRect(renderer, rect.x, rect.y, rect.w, rect.h, 10);
+        if (i == game->selected || i == hintFrom || i == hintTo) {
+            renderSelection(renderer, board, x, layout->piles[i].y);
         }
 
         // Dessiner les jetons
         for (int j = 0; j < game->piles[i].count; j++) {
-            // Position du jeton dans la pile
-            int tokenY = rect.y + pileHeight - (j + 1) * (tokenHeight + tokenSpacing);
-            int tokenX = rect.x + 5;
-            if (!currentAnimation.active || !(tokenY==currentAnimation.destY && tokenX==currentAnimation.destX && game->piles[i].colors[j]==currentAnimation.colorIndex) ){
-                drawToken(renderer, tokenX, tokenY, pileWidth - 10, tokenHeight, COLORS[game->piles[i].colors[j]]);
+            // Un jeton en route est dessiné par son animation
+            if (animForToken(&animations, i, j) == NO_ANIMATION) {
+                renderToken(renderer, board, x + board->tokenInset, layout->slotY[j], game->piles[i].colors[j]);
             }
         }
     }
     
-    // Dessiner animation de jeton si active
-    if (currentAnimation.active) {
-        // Calculer la position intermédiaire
-        float easedProgress = sin(currentAnimation.progress * M_PI / 2); // Easing function
-        int x = currentAnimation.sourceX + (currentAnimation.destX - currentAnimation.sourceX) * easedProgress;
-        int y = currentAnimation.sourceY + (currentAnimation.destY - currentAnimation.sourceY) * easedProgress;
-        
-        // Dessiner le jeton animé
-        drawToken(renderer, x, y, pileWidth - 10, tokenHeight, 
-                COLORS[currentAnimation.colorIndex]);
+    // Dessiner les jetons animés par-dessus, à leur position interpolée
+    for (int id = 0; id < animations.count; id++) {
+        float x, y;
+        animPosition(&animations, id, simulationAlpha, &x, &y);
+        if (x + board->tokenWidth < 0 || x >= WINDOW_WIDTH) continue;
+        renderToken(renderer, board, (int)x, (int)y, animations.color[id]);
     }
+    endBoard(renderer);
+    profileEnd("board", stage);
     
     // Dessiner les boutons en bas de l'écran (seulement si on n'est pas sur l'écran de victoire)
+    stage = profileBegin();
     if (game->status != GAME_WON) {
-        // Bouton Restart
-        Button restartButton = {
-            {20, WINDOW_HEIGHT - 70, 150, 50},
-            "Restart",
-            false,
-            actionRestart,
-            game
-        };
-        
-        // Bouton Main Menu
-        Button menuButton = {
-            {190, WINDOW_HEIGHT - 70, 150, 50},
-            "Main Menu",
-            false,
-            actionBackToMenu,
-            game
-        };
-        
-        // Bouton Quit
-        Button quitButton = {
-            {WINDOW_WIDTH - 170, WINDOW_HEIGHT - 70, 150, 50},
-            "Quit",
-            false,
-            actionQuit,
-            NULL
-        };
-        
-        // Vérifier si la souris survole les boutons
-        int mouseX, mouseY;
-        SDL_GetMouseState(&mouseX, &mouseY);
-        restartButton.hover = isPointInRect(mouseX, mouseY, &restartButton.rect);
-        menuButton.hover = isPointInRect(mouseX, mouseY, &menuButton.rect);
-        quitButton.hover = isPointInRect(mouseX, mouseY, &quitButton.rect);
-        
-        renderButton(renderer, font, &restartButton);
-        renderButton(renderer, font, &menuButton);
-        renderButton(renderer, font, &quitButton);
+        Button *buttons = layout->gameButtons;
+        buttons[GAME_HINT].text = hintWaiting ? "..." : "Hint";
+        int hover = hitButton(buttons, GAME_BUTTONS, pointerX, pointerY);
+        for (int b = 0; b < GAME_BUTTONS; b++) {
+            buttons[b].hover = b == hover;
+            if (b == GAME_UNDO && !moveLogCanUndo(&moveLog)) continue;
+            if (b == GAME_REDO && !moveLogCanRedo(&moveLog)) continue;
+            renderButton(renderer, font, &buttons[b]);
+        }
     }
+    profileEnd("buttons", stage);
     
     // Afficher l'écran de victoire si le jeu est gagné
     if (game->status == GAME_WON) {
+        stage = profileBegin();
         renderWinScreen(renderer, font, largeFont, game);
+        profileEnd("win screen", stage);
     }
 
-    SDL_RenderPresent(renderer);
-}
+    if (showProfiler) {
+        renderProfilerOverlay(renderer, font);
+    }
 
+    stage = profileBegin();
+    presentFrame(renderer);
+    profileEnd("present", stage);
+}
 
 void handleClick(GameState *game, int x, int y) {
+    const ScreenLayout *layout = screenLayout(game);
+
+    // Sur l'écran de victoire, seuls ses boutons répondent
     if (game->status == GAME_WON) {
-        // Vérifier les clics sur les boutons de l'écran de victoire
-        Button restartButton = {
-            {WINDOW_WIDTH / 2 - 270, WINDOW_HEIGHT / 2 + 100, 160, 60},
-            "Play Again",
-            false,
-            actionRestart,
-            game
-        };
-        
-        Button menuButton = {
-            {WINDOW_WIDTH / 2 - 80, WINDOW_HEIGHT / 2 + 100, 160, 60},
-            "Main Menu",
-            false,
-            actionBackToMenu,
-            game
-        };
-        
-        Button quitButton = {
-            {WINDOW_WIDTH / 2 + 110, WINDOW_HEIGHT / 2 + 100, 160, 60},
-            "Quit",
-            false,
-            actionQuit,
-            NULL
-        };
-        
-        if (isPointInRect(x, y, &restartButton.rect)) {
-            restartButton.action(restartButton.data);
-            return;
-        }
-        
-        if (isPointInRect(x, y, &menuButton.rect)) {
-            menuButton.action(menuButton.data);
-            return;
-        }
-        
-        if (isPointInRect(x, y, &quitButton.rect)) {
-            quitButton.action(quitButton.data);
-            return;
-        }
-        
+        int b = hitButton(layout->winButtons, WIN_BUTTONS, x, y);
+        if (b >= 0) layout->winButtons[b].action(layout->winButtons[b].data);
         return;
     }
     
-    // Vérifier les clics sur les boutons du jeu (si pas en animation)
-    if (!currentAnimation.active) {
-        // Bouton Restart
-        Button restartButton = {
-            {20, WINDOW_HEIGHT - 70, 150, 50},
-            "Restart",
-            false,
-            actionRestart,
-            game
-        };
-        
-        // Bouton Main Menu
-        Button menuButton = {
-            {190, WINDOW_HEIGHT - 70, 150, 50},
-            "Main Menu",
-            false,
-            actionBackToMenu,
-            game
-        };
-        
-        // Bouton Quit
-        Button quitButton = {
-            {WINDOW_WIDTH - 170, WINDOW_HEIGHT - 70, 150, 50},
-            "Quit",
-            false,
-            actionQuit,
-            NULL
-        };
-        
-        if (isPointInRect(x, y, &restartButton.rect)) {
-            restartButton.action(restartButton.data);
-            return;
-        }
-        
-        if (isPointInRect(x, y, &menuButton.rect)) {
-            menuButton.action(menuButton.data);
-            return;
-        }
-        
-        if (isPointInRect(x, y, &quitButton.rect)) {
-            quitButton.action(quitButton.data);
-            return;
-        }
+    // Vérifier les clics sur les boutons du jeu, y compris pendant les animations
+    int b = hitButton(layout->gameButtons, GAME_BUTTONS, x, y);
+    if (b >= 0) {
+        layout->gameButtons[b].action(layout->gameButtons[b].data);
+        return;
     }
     
-    if (currentAnimation.active) return; // Ne pas permettre de cliquer pendant l'animation
-    
-    // Calculer les dimensions des piles
-    int pileWidth = 80;
-    int pileHeight = 350;
-    int pileSpacing = 30;
-    int startX = (WINDOW_WIDTH - (game->numPiles * (pileWidth + pileSpacing) - pileSpacing)) / 2;
-    int startY = 120;
-    
     // Vérifier si le clic est sur une pile
-    for (int i = 0; i < game->numPiles; i++) {
-        SDL_Rect pileRect = {startX + i * (pileWidth + pileSpacing), startY, pileWidth, pileHeight};
-        
-        if (isPointInRect(x, y, &pileRect)) {
-            // Si aucune pile n'est sélectionnée, sélectionner celle-ci
-            if (game->selected == -1) {
-                // Ne sélectionner que si la pile n'est pas vide
-                if (game->piles[i].count > 0) {
-                    game->selected = i;
-                }
-            } 
-            // Si une pile est déjà sélectionnée
-            else {
-                // Si on clique sur la même pile, désélectionner
-                if (game->selected == i) {
-                    game->selected = -1;
-                } 
-                // Sinon, tenter de déplacer le jeton
-                else {
-                    // MODIFICATION: Vérifier uniquement si la pile de destination a de la place
-                    // (suppression de la contrainte de couleur)
-                    
-                    Pile *src = &game->piles[game->selected];
-                    Pile *dest = &game->piles[i];
-                    
-                    if (dest->count < game->maxTokens) {
-                        int sourceTokenColor = src->colors[src->count - 1];
-                        
-                        // MODIFICATION: Autoriser le déplacement sans vérifier la couleur
-                        // Calculer les positions pour l'animation
-                        int tokenHeight = 50;
-                        int tokenSpacing = 10;
-                        int srcTokenX = startX + game->selected * (pileWidth + pileSpacing) + 5;
-                        int srcTokenY = startY + pileHeight - src->count * (tokenHeight + tokenSpacing);
-                        int destTokenX = startX + i * (pileWidth + pileSpacing) + 5;
-                        int destTokenY = startY + pileHeight - (dest->count + 1) * (tokenHeight + tokenSpacing);
-                        
-                        // Démarrer l'animation
-                        startTokenAnimation(srcTokenX, srcTokenY, destTokenX, destTokenY, sourceTokenColor);
-                        
-                        // Transférer le jeton
-                        dest->colors[dest->count++] = sourceTokenColor;
-                        src->count--;
-                        
-                        // Incrémenter le compteur de mouvements
-                        game->moveCount++;
-                        
-                        // Désélectionner
-                        game->selected = -1;
-                        
-                        // Vérifier si le joueur a gagné
-                        if (checkWin(game)) {
-                            game->status = GAME_WON;
-                            game->endTime = SDL_GetTicks(); // Enregistrer le temps de fin
-                        }
-                    }
+    int i = hitPile(layout, x, y);
+    if (i < 0) return;
+
+    // Si aucune pile n'est sélectionnée, sélectionner celle-ci
+    if (game->selected == -1) {
+        // Ne sélectionner que si la pile n'est pas vide
+        if (game->piles[i].count > 0) {
+            game->selected = i;
+        }
+    } 
+    // Si une pile est déjà sélectionnée
+    else {
+        // Si on clique sur la même pile, désélectionner
+        if (game->selected == i) {
+            game->selected = -1;
+        } 
+        // Sinon, tenter de déplacer le jeton
+        else {
+            // MODIFICATION: Vérifier uniquement si la pile de destination a de la place
+            // (suppression de la contrainte de couleur)
+            
+            if (canMoveToken(game, game->selected, i)) {
+                // MODIFICATION: Autoriser le déplacement sans vérifier la couleur
+                // Transférer le jeton, l'animer et l'inscrire au journal
+                moveToken(game, game->selected, i);
+                clearHint();
+                animateMove(game, game->selected, i);
+                moveLogPush(&moveLog, game->selected, i);
+                recordMove(game, game->selected, i);
+                
+                // Incrémenter le compteur de mouvements
+                game->moveCount++;
+                
+                // Désélectionner
+                game->selected = -1;
+                
+                // Vérifier si le joueur a gagné
+                if (checkWin(game)) {
+                    game->status = GAME_WON;
+                    game->endTime = SDL_GetTicks(); // Enregistrer le temps de fin
                 }
             }
+        }
+    }
+}
+
+
+
+// Relecture en temps réel : plateau de départ de l'enregistrement, coups joués à leur date
+void startPlayback(GameState *game) {
+    initGame(game, (DifficultyLevel)playback.header.level);
+    replayStart(&playback, game);
+    recording = false;
+    playing = true;
+    playbackNext = 0;
+}
+
+// Joue les coups arrivés à échéance ; retourne le délai (ms) jusqu'au suivant, -1 s'il n'y en a plus
+int updatePlayback(GameState *game) {
+    Uint32 elapsed = SDL_GetTicks() - game->startTime;
+    while (playing && playbackNext < playback.numMoves && playback.moves[playbackNext].time <= elapsed) {
+        const ReplayMove *move = &playback.moves[playbackNext++];
+        if (game->status != GAME_PLAYING || !canMoveToken(game, move->from, move->to)) {
+            printf("Relecture interrompue : coup %u illégal\n", playbackNext - 1);
+            playing = false;
             break;
         }
+        moveToken(game, move->from, move->to);
+        clearHint();
+        animateMove(game, move->from, move->to);
+        moveLogPush(&moveLog, move->from, move->to);
+        game->moveCount++;
+        game->selected = -1;
+        if (checkWin(game)) {
+            game->status = GAME_WON;
+            game->endTime = SDL_GetTicks();
+        }
     }
+    if (!playing || playbackNext == playback.numMoves) {
+        playing = false;
+        return -1;
+    }
+    return (int)(playback.moves[playbackNext].time - elapsed);
 }
 
+// Les coups sont appliqués tout de suite, animations en cours ou non ; un retour au menu
+// abandonne les clics suivants
+void processClicks(GameState *game) {
+    int x, y;
+    while (game->currentLevel != LEVEL_NONE && nextClick(&x, &y)) {
+        handleClick(game, x, y);
+    }
+    clickQueue.head = clickQueue.tail;
+}
 
+#ifdef RENDER_BENCH
+// Banc de rendu hors écran (make bench-render) : une séquence fixe de menus, de plateaux et
+// de coups passe par renderLevelMenu et renderGame (écran de victoire compris) dans un
+// renderer logiciel sans fenêtre. Une ligne JSON par scène est écrite sur la sortie standard.
+// Avec --software, le même renderer sert de fenêtre au mode logiciel (voir SoftwareFrame).
+#define BENCH_MENU_FRAMES 60
+#define BENCH_ANIMATION_FRAMES 8
+#define BENCH_WIN_FRAMES 30
+#define BENCH_SOLVER_NODES 500000
+#define BENCH_FALLBACK_MOVES 24
+#define BENCH_LARGE_PILES 64            // Plus grand plateau (LEVEL_CUSTOM)
+#define BENCH_LARGE_TOKENS 16
+#define BENCH_LARGE_COLORS 32
+#define BENCH_PAN_FRAMES 120
+#define BENCH_PAN_STEP 40               // Défilement par image (px)
+#define BENCH_MAX_FRAMES 4096           // Durées gardées par scène pour les percentiles
+
+typedef struct {
+    const char *name;
+    int frames;
+    uint64_t ticks;
+    float frameMs[BENCH_MAX_FRAMES];
+    uint64_t drawCalls;
+    uint64_t allocations;
+    uint64_t frameStart;
+    RenderStats statsStart;
+} BenchScene;
+
+void benchFrameBegin(BenchScene *scene) {
+    scene->statsStart = renderStatsRead();
+    scene->frameStart = SDL_GetPerformanceCounter();
+}
+
+void benchFrameEnd(BenchScene *scene) {
+    uint64_t end = SDL_GetPerformanceCounter();
+    RenderStats stats = renderStatsRead();
+    scene->ticks += end - scene->frameStart;
+    if (scene->frames < BENCH_MAX_FRAMES) {
+        scene->frameMs[scene->frames] = (float)((end - scene->frameStart) * 1000.0 / SDL_GetPerformanceFrequency());
+    }
+    scene->drawCalls += stats.drawCalls - scene->statsStart.drawCalls;
+    scene->allocations += stats.allocations - scene->statsStart.allocations;
+    scene->frames++;
+}
+
+void benchAccumulate(BenchScene *total, const BenchScene *scene) {
+    for (int i = 0; i < scene->frames && total->frames + i < BENCH_MAX_FRAMES; i++) {
+        total->frameMs[total->frames + i] = scene->frameMs[i];
+    }
+    total->frames += scene->frames;
+    total->ticks += scene->ticks;
+    total->drawCalls += scene->drawCalls;
+    total->allocations += scene->allocations;
+}
+
+int compareFrameMs(const void *a, const void *b) {
+    float x = *(const float *)a, y = *(const float *)b;
+    return (x > y) - (x < y);
+}
+
+// Percentiles comme profilerFrameStats, sur les BENCH_MAX_FRAMES premières images
+void benchReport(BenchScene *scene) {
+    int frames = scene->frames ? scene->frames : 1;
+    int kept = scene->frames < BENCH_MAX_FRAMES ? scene->frames : BENCH_MAX_FRAMES;
+    qsort(scene->frameMs, kept, sizeof(float), compareFrameMs);
+    double p50 = kept ? scene->frameMs[(kept - 1) / 2] : 0;
+    double p99 = kept ? scene->frameMs[(kept - 1) * 99 / 100] : 0;
+    printf("{\"scene\":\"%s\",\"mode\":\"%s\",\"frames\":%d,\"ms_per_frame\":%.4f,\"p50_ms\":%.4f,\"p99_ms\":%.4f,\"draw_calls_per_frame\":%.2f,\"allocs_per_frame\":%.2f}\n",
+           scene->name, software.enabled ? "software" : "renderer", scene->frames,
+           scene->ticks * 1000.0 / SDL_GetPerformanceFrequency() / frames, p50, p99,
+           (double)scene->drawCalls / frames, (double)scene->allocations / frames);
+}
+
+// Clic au centre de la pile, dans la disposition partagée avec renderGame et handleClick
+void benchClickPile(GameState *game, int pile) {
+    SDL_Rect rect = screenLayout(game)->piles[pile];
+    handleClick(game, rect.x + rect.w / 2, rect.y + rect.h / 2);
+}
+
+void benchMenu(SDL_Renderer *renderer, TextFont *font, TextFont *titleFont, BenchScene *scene) {
+    DifficultyLevel selected = LEVEL_NONE;
+    Button buttons[MENU_BUTTONS];
+    initMenuButtons(buttons, &selected);
+    SDL_Texture *bgTexture = createMenuBackground(renderer);
+
+    // Le survol passe d'un bouton à l'autre, puis aucun
+    renderLevelMenu(renderer, font, titleFont, bgTexture, buttons);
+    for (int i = 0; i < BENCH_MENU_FRAMES; i++) {
+        for (int b = 0; b < MENU_BUTTONS; b++) {
+            buttons[b].hover = b == i % (MENU_BUTTONS + 1);
+        }
+        benchFrameBegin(scene);
+        renderLevelMenu(renderer, font, titleFont, bgTexture, buttons);
+        benchFrameEnd(scene);
+    }
+    SDL_DestroyTexture(bgTexture);
+}
+
+// Joue la solution du plateau (ou des coups légaux fixes si le solveur abandonne) : une image
+// après la sélection, puis BENCH_ANIMATION_FRAMES images d'animation par coup
+void benchLevel(SDL_Renderer *renderer, TextFont *font, TextFont *largeFont, DifficultyLevel level,
+                BenchScene *scene, BenchScene *win) {
+    GameState game;
+    initGame(&game, level);
+
+    SolverResult solution;
+    bool solved = solveGame(&game, BENCH_SOLVER_NODES, &solution);
+    int numMoves = solved ? solution.numMoves : BENCH_FALLBACK_MOVES;
+
+    renderGame(renderer, &game, font, largeFont);
+    for (int m = 0; m < numMoves && game.status == GAME_PLAYING; m++) {
+        int from = 0, to = 0;
+        if (solved) {
+            from = solution.moves[m].from;
+            to = solution.moves[m].to;
+        } else {
+            from = m % game.numPiles;
+            while (game.piles[from].count == 0) from = (from + 1) % game.numPiles;
+            to = (from + 1) % game.numPiles;
+            while (!canMoveToken(&game, from, to)) to = (to + 1) % game.numPiles;
+        }
+
+        benchClickPile(&game, from);
+        benchFrameBegin(scene);
+        renderGame(renderer, &game, font, largeFont);
+        benchFrameEnd(scene);
+
+        // Progression imposée plutôt que l'horloge : le même nombre d'images sur toute machine
+        benchClickPile(&game, to);
+        for (int f = 1; f <= BENCH_ANIMATION_FRAMES; f++) {
+            animStep(&animations, (float)ANIMATION_DURATION / BENCH_ANIMATION_FRAMES);
+            benchFrameBegin(scene);
+            renderGame(renderer, &game, font, largeFont);
+            benchFrameEnd(scene);
+        }
+    }
+
+    if (game.status != GAME_WON) {
+        game.status = GAME_WON;
+        game.endTime = SDL_GetTicks();
+    }
+    for (int i = 0; i < BENCH_WIN_FRAMES; i++) {
+        benchFrameBegin(win);
+        renderGame(renderer, &game, font, largeFont);
+        benchFrameEnd(win);
+    }
+}
+
+// Grand plateau agrandi au maximum, parcouru d'un bord à l'autre : une image par pas de
+// défilement, la couche statique étant refaite à chaque fois
+void benchPan(SDL_Renderer *renderer, TextFont *font, TextFont *largeFont, BenchScene *scene) {
+    GameState game;
+    initGame(&game, LEVEL_CUSTOM);
+    zoomBoard(&game, (float)baseBoardWidth(&game));
+    for (int f = 0; f < BENCH_PAN_FRAMES; f++) {
+        scrollBoard(&game, f * BENCH_PAN_STEP);
+        benchFrameBegin(scene);
+        renderGame(renderer, &game, font, largeFont);
+        benchFrameEnd(scene);
+    }
+}
+
+int runRenderBenchmark(bool softwareOnly) {
+    renderStatsInit();
+    SDL_SetHint(SDL_HINT_VIDEODRIVER, "dummy");
+    if (SDL_Init(SDL_INIT_VIDEO) != 0) {
+        fprintf(stderr, "Erreur d'initialisation de SDL: %s\n", SDL_GetError());
+        return 1;
+    }
+    if (TTF_Init() != 0) {
+        fprintf(stderr, "Erreur d'initialisation de SDL_ttf: %s\n", TTF_GetError());
+        SDL_Quit();
+        return 1;
+    }
+
+    // Rendu logiciel dans une surface : textures cibles disponibles, aucun affichage requis
+    SDL_Surface *target = SDL_CreateRGBSurfaceWithFormat(0, WINDOW_WIDTH, WINDOW_HEIGHT, 32, SDL_PIXELFORMAT_RGBA8888);
+    SDL_Renderer *windowRenderer = target ? SDL_CreateSoftwareRenderer(target) : NULL;
+    SDL_Renderer *renderer = windowRenderer && softwareOnly ? softwareInit(windowRenderer) : windowRenderer;
+    if (!renderer) {
+        fprintf(stderr, "Erreur d'initialisation du banc: %s\n", SDL_GetError());
+        if (windowRenderer) SDL_DestroyRenderer(windowRenderer);
+        if (target) SDL_FreeSurface(target);
+        TTF_Quit();
+        SDL_Quit();
+        return 1;
+    }
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+
+    TextFont regularFont, boldFont;
+    TextFont *font = &regularFont, *largeFont = &boldFont;
+    initFonts(font, largeFont);
+    textCacheInit();
+    profilerInit();
+    animInit(&animations);
+    if (!moveLogInit(&moveLog, MOVELOG_INITIAL_CAPACITY)) {
+        fprintf(stderr, "Mémoire insuffisante pour le journal des coups\n");
+        closeFonts(font, largeFont);
+        softwareFree();
+        SDL_DestroyRenderer(windowRenderer);
+        SDL_FreeSurface(target);
+        TTF_Quit();
+        SDL_Quit();
+        return 1;
+    }
+    initPalette();
+    bakeSprites(renderer);
+
+    // Pas de fichier de niveaux : les plateaux ne dépendent que de la graine
+    rngSeed(1);
+    replayPath = NULL;
+
+    // Statiques : les durées par image sont trop grandes pour la pile
+    static BenchScene menu = {.name = "menu"};
+    static BenchScene levels[4] = {{.name = "easy"}, {.name = "medium"}, {.name = "hard"}, {.name = "large"}};
+    static BenchScene pan = {.name = "large_pan"};
+    static BenchScene win = {.name = "win"};
+    static BenchScene total = {.name = "total"};
+
+    benchMenu(renderer, font, largeFont, &menu);
+    setCustomShape(BENCH_LARGE_PILES, BENCH_LARGE_TOKENS, BENCH_LARGE_COLORS);
+    for (DifficultyLevel level = LEVEL_EASY; level <= LEVEL_CUSTOM; level++) {
+        benchLevel(renderer, font, largeFont, level, &levels[level - LEVEL_EASY], &win);
+    }
+    benchPan(renderer, font, largeFont, &pan);
+
+    benchReport(&menu);
+    benchAccumulate(&total, &menu);
+    for (int i = 0; i < 4; i++) {
+        benchReport(&levels[i]);
+        benchAccumulate(&total, &levels[i]);
+    }
+    benchReport(&pan);
+    benchAccumulate(&total, &pan);
+    benchReport(&win);
+    benchAccumulate(&total, &win);
+    benchReport(&total);
+
+    textCacheShutdown();
+    moveLogFree(&moveLog);
+    replayFree(&replay);
+    freeSprites();
+    batchFree(&boardBatch);
+    if (staticLayer.texture) SDL_DestroyTexture(staticLayer.texture);
+    closeFonts(font, largeFont);
+    softwareFree();
+    SDL_DestroyRenderer(windowRenderer);
+    SDL_FreeSurface(target);
+    TTF_Quit();
+    SDL_Quit();
+    return 0;
+}
+#endif
 
 
 int main(int argc, char* argv[]) {
-    (void)argc;
-    (void)argv;
+#ifdef RENDER_BENCH
+    return runRenderBenchmark(argc > 1 && strcmp(argv[1], "--software") == 0);
+#endif
+
+    // --trace fichier : écrire la trace du profileur en quittant
+    // --record fichier : où écrire chaque partie (REPLAY_DEFAULT_PATH par défaut)
+    // --replay fichier : rejouer une partie enregistrée en temps réel
+    // --board PxJxC : plateau personnalisé de P piles de J jetons en C couleurs
+    // --software : rastériser l'écran sur le processeur (voir SoftwareFrame)
+    const char *tracePath = NULL;
+    const char *playbackPath = NULL;
+    bool customBoard = false;
+    bool softwareOnly = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            tracePath = argv[++i];
+        } else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            replayPath = argv[++i];
+        } else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            playbackPath = argv[++i];
+        } else if (strcmp(argv[i], "--board") == 0 && i + 1 < argc) {
+            int piles, tokens, colors;
+            if (sscanf(argv[++i], "%dx%dx%d", &piles, &tokens, &colors) != 3 ||
+                !setCustomShape(piles, tokens, colors)) {
+                printf("Plateau invalide : %s (au plus %dx%dx%d, moins de couleurs que de piles)\n",
+                       argv[i], MAX_PILES, MAX_TOKENS, MAX_COLORS);
+                return 1;
+            }
+            customBoard = true;
+        } else if (strcmp(argv[i], "--software") == 0) {
+            softwareOnly = true;
+        }
+    }
+    if (playbackPath && !replayRead(&playback, playbackPath)) {
+        printf("Impossible de lire la partie %s\n", playbackPath);
+        return 1;
+    }
+
     // Initialisation de SDL
     if (SDL_Init(SDL_INIT_VIDEO) != 0) {
         printf("Erreur d'initialisation de SDL: %s\n", SDL_GetError());
@@ -907,7 +1876,7 @@ int main(int argc, char* argv[]) {
                                         SDL_WINDOWPOS_CENTERED,
                                         SDL_WINDOWPOS_CENTERED,
                                         WINDOW_WIDTH, WINDOW_HEIGHT,
-                                        SDL_WINDOW_SHOWN);
+                                        SDL_WINDOW_SHOWN | SDL_WINDOW_RESIZABLE | SDL_WINDOW_ALLOW_HIGHDPI);
     if (!window) {
         printf("Erreur de création de la fenêtre: %s\n", SDL_GetError());
         TTF_Quit();
@@ -915,36 +1884,85 @@ int main(int argc, char* argv[]) {
         return 1;
     }
     
-    // Création du renderer
-    SDL_Renderer *renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
-    if (!renderer) {
+    // Création du renderer de la fenêtre, logiciel s'il n'y a pas de rendu accéléré
+    SDL_Renderer *windowRenderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+    if (!windowRenderer) windowRenderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_SOFTWARE);
+    if (!windowRenderer) {
         printf("Erreur de création du renderer: %s\n", SDL_GetError());
         SDL_DestroyWindow(window);
         TTF_Quit();
         SDL_Quit();
         return 1;
     }
+    // Tout est disposé dans un écran logique de WINDOW_WIDTH x WINDOW_HEIGHT : SDL le met à
+    // l'échelle de la fenêtre (agrandie ou HiDPI) et y ramène les coordonnées de la souris
+    SDL_RenderSetLogicalSize(windowRenderer, WINDOW_WIDTH, WINDOW_HEIGHT);
+
+    // Sans accélération, les primitives de SDL passent par son rendu générique : l'écran est
+    // alors rastérisé par spans et envoyé en une fois
+    SDL_RendererInfo rendererInfo;
+    bool accelerated = SDL_GetRendererInfo(windowRenderer, &rendererInfo) == 0 &&
+                       (rendererInfo.flags & SDL_RENDERER_ACCELERATED);
+    SDL_Renderer *renderer = softwareOnly || !accelerated ? softwareInit(windowRenderer) : NULL;
+    if (renderer) printf("Rendu logiciel : formes rastérisées par spans\n");
+    else renderer = windowRenderer;
     
-    // Chargement des polices
-    TTF_Font* font = TTF_OpenFont("/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf", 24);
-    TTF_Font *largeFont = TTF_OpenFont("/usr/share/fonts/truetype/dejavu/DejaVuSans-Bold.ttf", 36);
-    if (!font || !largeFont) {
-        printf("Erreur de chargement des polices: %s\n", TTF_GetError());
-        SDL_DestroyRenderer(renderer);
+    // Polices : l'atlas de glyphes s'il existe, les fichiers TTF seulement en secours
+    TextFont regularFont, boldFont;
+    TextFont *font = &regularFont, *largeFont = &boldFont;
+    initFonts(font, largeFont);
+    textCacheInit();
+    profilerInit();
+    animInit(&animations);
+    // Sans journal, chaque coup écrirait hors du tampon (capacité nulle)
+    if (!moveLogInit(&moveLog, MOVELOG_INITIAL_CAPACITY)) {
+        printf("Mémoire insuffisante pour le journal des coups\n");
+        closeFonts(font, largeFont);
+        softwareFree();
+        SDL_DestroyRenderer(windowRenderer);
         SDL_DestroyWindow(window);
         TTF_Quit();
         SDL_Quit();
         return 1;
     }
-    
+    if (!hintStart(&hints, wakeMainLoop)) {
+        printf("Impossible de démarrer le thread d'indices\n");
+    }
+    initPalette();
+    bakeSprites(renderer);
+
     // Initialisation du jeu
+    rngSeed((uint64_t)time(NULL) ^ SDL_GetPerformanceCounter());
+    if (levelPackOpen(&levelPack, LEVELPACK_DEFAULT_PATH)) {
+        printf("%u niveaux chargés depuis %s\n", levelPack.header->numRecords, LEVELPACK_DEFAULT_PATH);
+    }
     GameState game;
     game.currentLevel = LEVEL_NONE;
     game.status = GAME_PLAYING;
+    if (playbackPath) startPlayback(&game);
+    else if (customBoard) initGame(&game, LEVEL_CUSTOM);
     
-    // Boucle principale
+    // Boucle principale : rendu à la demande. On dort dans SDL_WaitEventTimeout tant que rien
+    // ne change ; une image n'est produite que sur une entrée, une animation en cours ou un
+    // changement de seconde du chronomètre.
+    // Les animations avancent par pas fixes de 1/SIMULATION_RATE s (SDL_GetPerformanceCounter),
+    // le rendu interpole entre les deux derniers pas : la vitesse ne dépend pas de l'écran.
     SDL_Event event;
     bool quit = false;
+    bool dirty = true;
+    int shownSecond = -1;
+    uint64_t frequency = SDL_GetPerformanceFrequency();
+    uint64_t stepTicks = frequency / SIMULATION_RATE;
+    uint64_t backgroundTicks = frequency * BACKGROUND_FRAME_INTERVAL / 1000;
+    uint64_t lastFrame = 0;
+    uint64_t lastStep = SDL_GetPerformanceCounter();
+    uint64_t lag = 0;
+
+    // Avec la synchronisation verticale, SDL_RenderPresent cadence déjà les images ; sinon on
+    // les espace d'une période de rafraîchissement de l'écran de la fenêtre
+    bool vsync = SDL_GetRendererInfo(windowRenderer, &rendererInfo) == 0 &&
+                 (rendererInfo.flags & SDL_RENDERER_PRESENTVSYNC);
+    uint64_t refreshTicks = frequency / displayRefreshRate(window);
     
     while (!quit) {
         // Gérer le niveau de difficulté
@@ -953,40 +1971,166 @@ int main(int argc, char* argv[]) {
             if (game.currentLevel != LEVEL_NONE) {
                 initGame(&game, game.currentLevel);
             }
+            dirty = true;
+        }
+
+        Uint32 windowFlags = SDL_GetWindowFlags(window);
+        bool minimized = windowFlags & SDL_WINDOW_MINIMIZED;
+        bool focused = windowFlags & SDL_WINDOW_INPUT_FOCUS;
+
+        // Délai d'attente jusqu'à la prochaine image utile (arrondi à la ms inférieure : la fin
+        // de l'attente se fait en repassant dans la boucle)
+        uint64_t frameInterval = !focused ? backgroundTicks : vsync ? 0 : refreshTicks;
+        uint64_t now = SDL_GetPerformanceCounter();
+        int timeout = IDLE_TIMEOUT;
+        if (minimized) {
+            timeout = IDLE_TIMEOUT;
+        } else if (dirty || animActive(&animations)) {
+            timeout = now - lastFrame >= frameInterval ? 0 : (int)((frameInterval - (now - lastFrame)) * 1000 / frequency);
+        } else if (game.status == GAME_PLAYING) {
+            timeout = 1000 - (int)((SDL_GetTicks() - game.startTime) % 1000);
+        }
+        if (playing && !minimized) {
+            int untilMove = updatePlayback(&game);
+            if (untilMove >= 0 && untilMove < timeout) timeout = untilMove;
+            if (animActive(&animations)) timeout = 0;
         }
         
         // Traiter les événements
-        while (SDL_PollEvent(&event)) {
-            if (event.type == SDL_QUIT) {
-                quit = true;
-            } else if (event.type == SDL_MOUSEBUTTONDOWN) {
-                if (event.button.button == SDL_BUTTON_LEFT) {
-                    handleClick(&game, event.button.x, event.button.y);
+        bool woken = SDL_WaitEventTimeout(&event, timeout);
+        uint64_t frameStart = profileBegin();
+        // Une animation démarrée par ces évènements part de maintenant, pas d'avant l'attente
+        if (!animActive(&animations)) lastStep = frameStart;
+        if (woken) {
+            do {
+                if (event.type == SDL_QUIT) {
+                    quit = true;
+                } else if (event.type == SDL_WINDOWEVENT) {
+                    // La fenêtre a pu changer d'écran ou de taille
+                    refreshTicks = frequency / displayRefreshRate(window);
+                    if (event.window.event == SDL_WINDOWEVENT_SIZE_CHANGED) screen.valid = false;
+                    dirty = true;
+                } else if (event.type == SDL_RENDER_TARGETS_RESET || event.type == SDL_RENDER_DEVICE_RESET) {
+                    // Le contenu des textures cibles a été perdu ; après une perte du
+                    // périphérique, toutes les textures (celles du texte aussi) sont invalides
+                    bakeSprites(renderer);
+                    if (event.type == SDL_RENDER_DEVICE_RESET) {
+                        textCacheFlush();
+                        if (software.enabled) softwareCreateTexture();
+                        // Recréée par renderStaticLayer
+                        if (staticLayer.texture) SDL_DestroyTexture(staticLayer.texture);
+                        staticLayer.texture = NULL;
+                    }
+                    staticLayer.valid = false;
+                    dirty = true;
+                } else if (event.type == SDL_MOUSEMOTION) {
+                    pointerX = event.motion.x;
+                    pointerY = event.motion.y;
+                    dirty = true;  // Survol des boutons
+                } else if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_F3) {
+                    showProfiler = !showProfiler;
+                    dirty = true;
+                } else if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_F4) {
+                    profilerDumpTrace(TRACE_DEFAULT_PATH);
+                } else if (event.type == SDL_KEYDOWN && (event.key.keysym.mod & KMOD_CTRL) &&
+                           game.currentLevel != LEVEL_NONE) {
+                    // Ctrl+Z annule, Ctrl+Y ou Ctrl+Maj+Z rejoue (après les clics qui précèdent)
+                    processClicks(&game);
+                    bool shift = event.key.keysym.mod & KMOD_SHIFT;
+                    if (event.key.keysym.sym == SDLK_z && !shift) actionUndo(&game);
+                    if (event.key.keysym.sym == SDLK_y || (event.key.keysym.sym == SDLK_z && shift)) actionRedo(&game);
+                    dirty = true;
+                } else if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_h &&
+                           game.currentLevel != LEVEL_NONE) {
+                    // H : indice, comme le bouton Hint
+                    processClicks(&game);
+                    actionHint(&game);
+                    dirty = true;
+                } else if (event.type == SDL_KEYDOWN && game.currentLevel != LEVEL_NONE) {
+                    // +/- zooment, les flèches font défiler les grands plateaux
+                    processClicks(&game);
+                    SDL_Keycode key = event.key.keysym.sym;
+                    if (key == SDLK_PLUS || key == SDLK_EQUALS || key == SDLK_KP_PLUS) zoomBoard(&game, ZOOM_STEP);
+                    if (key == SDLK_MINUS || key == SDLK_KP_MINUS) zoomBoard(&game, 1.0f / ZOOM_STEP);
+                    if (key == SDLK_LEFT) scrollBoard(&game, boardView.scroll - SCROLL_STEP);
+                    if (key == SDLK_RIGHT) scrollBoard(&game, boardView.scroll + SCROLL_STEP);
+                    dirty = true;
+                } else if (event.type == SDL_MOUSEWHEEL && game.currentLevel != LEVEL_NONE) {
+                    // Molette : zoom ; défilement horizontal (pavé tactile) : défilement
+                    processClicks(&game);
+                    if (event.wheel.y) zoomBoard(&game, powf(ZOOM_STEP, (float)event.wheel.y));
+                    if (event.wheel.x) scrollBoard(&game, boardView.scroll + event.wheel.x * SCROLL_STEP / 2);
+                    dirty = true;
+                } else if (event.type == SDL_MOUSEBUTTONDOWN) {
+                    if (event.button.button == SDL_BUTTON_LEFT) {
+                        queueClick(event.button.x, event.button.y);
+                        dirty = true;
+                    }
                 }
-            }
+            } while (SDL_PollEvent(&event));
+            processClicks(&game);
+            profileEnd("events", frameStart);
         }
+        if (quit || game.currentLevel == LEVEL_NONE) continue;
+
+        // Résultat du thread d'indices (il réveille la boucle par un SDL_USEREVENT)
+        if (updateHint()) dirty = true;
         
-        // Mettre à jour l'animation
-        updateAnimation();
-        
-        // Vérifier si le joueur a gagné (après la fin de l'animation)
-        if (!currentAnimation.active && game.status == GAME_PLAYING && game.currentLevel != LEVEL_NONE) {
-            if (checkWin(&game)) {
-                game.status = GAME_WON;
-                game.endTime = SDL_GetTicks();
+        // Pas fixes de simulation pour le temps écoulé ; sans animation il n'y a rien à
+        // rattraper (la dernière étape doit aussi être affichée)
+        uint64_t stage = profileBegin();
+        now = SDL_GetPerformanceCounter();
+        lag += now - lastStep;
+        lastStep = now;
+        if (animActive(&animations)) {
+            dirty = true;
+            if (lag > frequency * MAX_SIMULATION_LAG / 1000) lag = frequency * MAX_SIMULATION_LAG / 1000;
+            while (lag >= stepTicks && animActive(&animations)) {
+                updateAnimation();
+                lag -= stepTicks;
             }
         }
+        if (!animActive(&animations)) lag = 0;
+        simulationAlpha = (float)lag / stepTicks;
+        profileEnd("updateAnimation", stage);
         
-        // Rendre le jeu
-        renderGame(renderer, &game, font, largeFont);
+        // Le chronomètre affiche des secondes entières
+        if (game.status == GAME_PLAYING) {
+            int second = (int)((SDL_GetTicks() - game.startTime) / 1000);
+            if (second != shownSecond) dirty = true;
+            shownSecond = second;
+        }
         
-        SDL_Delay(16); // ~60 FPS
+        // Rendre le jeu (rien à afficher si la fenêtre est réduite). Une entrée est affichée
+        // sans attendre ; seules les images d'animation sont espacées d'une période.
+        now = SDL_GetPerformanceCounter();
+        if (dirty && !minimized) {
+            uint64_t interval = !focused || animActive(&animations) ? frameInterval : 0;
+            if (now - lastFrame >= interval) {
+                renderGame(renderer, &game, font, largeFont);
+                profileFrame(frameStart);
+                lastFrame = now;
+                dirty = false;
+            }
+        }
     }
     
+    if (tracePath) profilerDumpTrace(tracePath);
+    saveReplay();
+
     // Libération des ressources
-    TTF_CloseFont(font);
-    TTF_CloseFont(largeFont);
-    SDL_DestroyRenderer(renderer);
+    replayFree(&replay);
+    replayFree(&playback);
+    levelPackClose(&levelPack);
+    hintStop(&hints);
+    textCacheShutdown();
+    moveLogFree(&moveLog);
+    freeSprites();
+    batchFree(&boardBatch);
+    if (staticLayer.texture) SDL_DestroyTexture(staticLayer.texture);
+    closeFonts(font, largeFont);
+    softwareFree();
+    SDL_DestroyRenderer(windowRenderer);
     SDL_DestroyWindow(window);
     TTF_Quit();
     SDL_Quit();
@@ -0,0 +1,68 @@
+#include "movelog.h"
+#include <stdlib.h>
+#include <string.h>
+
+bool moveLogInit(MoveLog *log, uint32_t capacity) {
+    memset(log, 0, sizeof(*log));
+    log->moves = malloc(capacity * sizeof(MoveRecord));
+    if (!log->moves) return false;
+    log->capacity = capacity;
+    return true;
+}
+
+void moveLogFree(MoveLog *log) {
+    free(log->moves);
+    memset(log, 0, sizeof(*log));
+}
+
+void moveLogClear(MoveLog *log) {
+    log->head = log->cursor = log->tail = 0;
+}
+
+static MoveRecord *at(const MoveLog *log, uint64_t position) {
+    return &log->moves[position & (log->capacity - 1)];
+}
+
+// Double l'anneau en remettant les coups dans l'ordre à partir de 0 ; false si la mémoire manque
+static bool grow(MoveLog *log) {
+    uint32_t capacity = log->capacity * 2;
+    MoveRecord *moves = malloc(capacity * sizeof(MoveRecord));
+    if (!moves) return false;
+    uint64_t count = log->tail - log->head;
+    for (uint64_t i = 0; i < count; i++) {
+        moves[i] = *at(log, log->head + i);
+    }
+    free(log->moves);
+    log->moves = moves;
+    log->capacity = capacity;
+    log->cursor -= log->head;
+    log->tail = count;
+    log->head = 0;
+    return true;
+}
+
+void moveLogPush(MoveLog *log, int from, int to) {
+    log->tail = log->cursor;
+    if (log->tail - log->head == log->capacity &&
+        (log->capacity >= MOVELOG_MAX_CAPACITY || !grow(log))) {
+        log->head++;
+    }
+    *at(log, log->cursor) = (MoveRecord){(uint8_t)from, (uint8_t)to};
+    log->tail = ++log->cursor;
+}
+
+bool moveLogUndo(MoveLog *log, GameState *game, MoveRecord *move) {
+    if (!moveLogCanUndo(log)) return false;
+    MoveRecord record = *at(log, --log->cursor);
+    moveToken(game, record.to, record.from);
+    if (move) *move = record;
+    return true;
+}
+
+bool moveLogRedo(MoveLog *log, GameState *game, MoveRecord *move) {
+    if (!moveLogCanRedo(log)) return false;
+    MoveRecord record = *at(log, log->cursor++);
+    moveToken(game, record.from, record.to);
+    if (move) *move = record;
+    return true;
+}
@@ -0,0 +1,52 @@
+#ifndef MOVELOG_H
+#define MOVELOG_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "game.h"
+
+// Journal des coups : 2 octets par coup dans un anneau qui double jusqu'à
+// MOVELOG_MAX_CAPACITY, puis oublie les plus anciens. Annuler ou rejouer un coup ne fait
+// que le rejouer dans un sens ou dans l'autre (tout coup est réversible sans contrainte de
+// couleur) : aucune copie de GameState. Sans SDL, utilisable par la recherche pour revenir
+// en arrière.
+#define MOVELOG_INITIAL_CAPACITY 256
+#define MOVELOG_MAX_CAPACITY (1u << 20)     // Puissances de deux
+
+typedef struct {
+    uint8_t from;
+    uint8_t to;
+} MoveRecord;
+
+// Positions croissantes sans fin, ramenées dans l'anneau par le masque :
+// [head, cursor) coups annulables, [cursor, tail) coups rejouables
+typedef struct {
+    MoveRecord *moves;
+    uint32_t capacity;
+    uint64_t head;
+    uint64_t cursor;
+    uint64_t tail;
+} MoveLog;
+
+bool moveLogInit(MoveLog *log, uint32_t capacity);
+void moveLogFree(MoveLog *log);
+void moveLogClear(MoveLog *log);
+
+// Enregistre un coup déjà joué ; les coups rejouables sont oubliés
+void moveLogPush(MoveLog *log, int from, int to);
+
+static inline bool moveLogCanUndo(const MoveLog *log) {
+    return log->cursor != log->head;
+}
+
+static inline bool moveLogCanRedo(const MoveLog *log) {
+    return log->cursor != log->tail;
+}
+
+// Défait le dernier coup sur game ; *move reçoit le coup annulé (peut être NULL)
+bool moveLogUndo(MoveLog *log, GameState *game, MoveRecord *move);
+
+// Rejoue le coup annulé le plus récent
+bool moveLogRedo(MoveLog *log, GameState *game, MoveRecord *move);
+
+#endif
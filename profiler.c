@@ -0,0 +1,131 @@
+#include "profiler.h"
+#include <SDL2/SDL.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// Les champs sont atomiques (accès relâchés) : un lecteur peut croiser un écrivain, la
+// séquence relue après copie détecte alors l'entrée incohérente
+typedef struct {
+    _Atomic uint64_t sequence;  // Ticket + 1 une fois l'entrée complète, 0 pendant l'écriture
+    _Atomic(const char *) name;
+    _Atomic uint64_t start;
+    _Atomic uint64_t duration;
+    _Atomic int thread;
+} ProfileEntry;
+
+typedef struct {
+    const char *name;
+    uint64_t start;
+    uint64_t duration;
+    int thread;
+} ProfileSample;
+
+static ProfileEntry ring[PROFILER_RING_SIZE];
+static _Atomic uint64_t ringHead;
+
+static _Atomic uint32_t frameTimes[PROFILER_FRAME_HISTORY];    // Microsecondes
+static _Atomic uint64_t frameHead;
+
+static uint64_t origin;
+static double ticksPerMicrosecond;
+
+static _Atomic int nextThread;
+static _Thread_local int threadId = -1;
+
+void profilerInit(void) {
+    origin = SDL_GetPerformanceCounter();
+    ticksPerMicrosecond = SDL_GetPerformanceFrequency() / 1e6;
+}
+
+uint64_t profilerNow(void) {
+    return SDL_GetPerformanceCounter();
+}
+
+static double toMicroseconds(uint64_t ticks) {
+    return ticks / ticksPerMicrosecond;
+}
+
+void profileEnd(const char *name, uint64_t start) {
+    uint64_t end = SDL_GetPerformanceCounter();
+    if (threadId < 0) threadId = atomic_fetch_add(&nextThread, 1);
+
+    uint64_t ticket = atomic_fetch_add_explicit(&ringHead, 1, memory_order_relaxed);
+    ProfileEntry *entry = &ring[ticket & (PROFILER_RING_SIZE - 1)];
+    atomic_store_explicit(&entry->sequence, 0, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&entry->name, name, memory_order_relaxed);
+    atomic_store_explicit(&entry->start, start, memory_order_relaxed);
+    atomic_store_explicit(&entry->duration, end - start, memory_order_relaxed);
+    atomic_store_explicit(&entry->thread, threadId, memory_order_relaxed);
+    atomic_store_explicit(&entry->sequence, ticket + 1, memory_order_release);
+}
+
+void profileFrame(uint64_t start) {
+    uint64_t end = SDL_GetPerformanceCounter();
+    profileEnd("frame", start);
+    uint64_t slot = atomic_fetch_add_explicit(&frameHead, 1, memory_order_relaxed);
+    atomic_store_explicit(&frameTimes[slot % PROFILER_FRAME_HISTORY],
+                          (uint32_t)toMicroseconds(end - start), memory_order_relaxed);
+}
+
+static int compareTimes(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+FrameStats profilerFrameStats(void) {
+    FrameStats stats = {0, 0, 0};
+    uint64_t head = atomic_load_explicit(&frameHead, memory_order_relaxed);
+    int n = head < PROFILER_FRAME_HISTORY ? (int)head : PROFILER_FRAME_HISTORY;
+    if (n == 0) return stats;
+
+    uint32_t times[PROFILER_FRAME_HISTORY];
+    for (int i = 0; i < n; i++) {
+        times[i] = atomic_load_explicit(&frameTimes[i], memory_order_relaxed);
+    }
+    qsort(times, n, sizeof(uint32_t), compareTimes);
+    stats.p50 = times[(n - 1) / 2] / 1000.0;
+    stats.p99 = times[(n - 1) * 99 / 100] / 1000.0;
+    stats.frames = n;
+    return stats;
+}
+
+// Copie cohérente d'une entrée, ou false si elle est en cours d'écriture ou déjà écrasée
+static bool readEntry(uint64_t ticket, ProfileSample *out) {
+    ProfileEntry *entry = &ring[ticket & (PROFILER_RING_SIZE - 1)];
+    if (atomic_load_explicit(&entry->sequence, memory_order_acquire) != ticket + 1) return false;
+    out->name = atomic_load_explicit(&entry->name, memory_order_relaxed);
+    out->start = atomic_load_explicit(&entry->start, memory_order_relaxed);
+    out->duration = atomic_load_explicit(&entry->duration, memory_order_relaxed);
+    out->thread = atomic_load_explicit(&entry->thread, memory_order_relaxed);
+    atomic_thread_fence(memory_order_acquire);
+    return atomic_load_explicit(&entry->sequence, memory_order_relaxed) == ticket + 1;
+}
+
+bool profilerDumpTrace(const char *path) {
+    FILE *file = fopen(path, "w");
+    if (!file) {
+        perror(path);
+        return false;
+    }
+
+    uint64_t head = atomic_load_explicit(&ringHead, memory_order_acquire);
+    uint64_t first = head > PROFILER_RING_SIZE ? head - PROFILER_RING_SIZE : 0;
+    int written = 0;
+
+    fprintf(file, "{\"traceEvents\":[\n");
+    for (uint64_t ticket = first; ticket < head; ticket++) {
+        ProfileSample entry;
+        if (!readEntry(ticket, &entry)) continue;
+        fprintf(file, "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.1f,\"dur\":%.1f}",
+                written++ ? ",\n" : "", entry.name, entry.thread,
+                toMicroseconds(entry.start - origin), toMicroseconds(entry.duration));
+    }
+    fprintf(file, "\n],\"displayTimeUnit\":\"ms\"}\n");
+
+    bool ok = !ferror(file);
+    if (fclose(file) != 0) ok = false;
+    if (ok) printf("%d évènements écrits dans %s\n", written, path);
+    return ok;
+}
@@ -0,0 +1,38 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Profileur intégré : les sections chronométrées sont écrites dans un anneau sans verrou
+// (plusieurs threads producteurs possibles), les durées d'image dans un second anneau.
+// Les anciennes mesures sont écrasées ; rien n'est alloué après profilerInit.
+#define PROFILER_RING_SIZE 8192     // Puissance de deux
+#define PROFILER_FRAME_HISTORY 256
+
+void profilerInit(void);
+
+uint64_t profilerNow(void);
+
+static inline uint64_t profileBegin(void) {
+    return profilerNow();
+}
+
+// name doit rester valide jusqu'à la fin du programme (chaîne littérale)
+void profileEnd(const char *name, uint64_t start);
+
+// Durée de travail d'une image effectivement rendue
+void profileFrame(uint64_t start);
+
+typedef struct {
+    double p50;     // ms
+    double p99;     // ms
+    int frames;
+} FrameStats;
+
+FrameStats profilerFrameStats(void);
+
+// Écrit le contenu de l'anneau au format trace_event de Chrome (chrome://tracing, Perfetto)
+bool profilerDumpTrace(const char *path);
+
+#endif
@@ -0,0 +1,169 @@
+#include "raster.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+bool canvasAlloc(Canvas *canvas, int width, int height) {
+    canvas->pixels = calloc((size_t)width * height, sizeof(uint32_t));
+    canvas->width = canvas->pixels ? width : 0;
+    canvas->height = canvas->pixels ? height : 0;
+    canvas->stride = canvas->width;
+    return canvas->pixels != NULL;
+}
+
+void canvasFree(Canvas *canvas) {
+    free(canvas->pixels);
+    memset(canvas, 0, sizeof(*canvas));
+}
+
+void canvasCopy(Canvas *dst, const Canvas *src) {
+    int width = dst->width < src->width ? dst->width : src->width;
+    int height = dst->height < src->height ? dst->height : src->height;
+    for (int y = 0; y < height; y++) {
+        memcpy(dst->pixels + (size_t)y * dst->stride, src->pixels + (size_t)y * src->stride, width * sizeof(uint32_t));
+    }
+}
+
+// Couleur opaque : quatre pixels par écriture
+static void fillSpan(uint32_t *row, int n, uint32_t color) {
+    int i = 0;
+#ifdef __SSE2__
+    __m128i c = _mm_set1_epi32((int)color);
+    for (; i + 4 <= n; i += 4) {
+        _mm_storeu_si128((__m128i *)(row + i), c);
+    }
+#endif
+    for (; i < n; i++) {
+        row[i] = color;
+    }
+}
+
+// Mélange par canal : (src * a + dst * (255 - a)) / 255 arrondi, la division étant faite par
+// (t + (t >> 8)) >> 8 avec t = somme + 128 (exact sur [0, 255 * 255]). L'alpha résultant est
+// calculé de même avec une source à 255. Scalaire et SSE2 donnent les mêmes octets.
+static void blendSpan(uint32_t *row, int n, uint32_t color) {
+    uint32_t alpha = color >> 24, inverse = 255 - alpha;
+    uint32_t source[4];
+    for (int k = 0; k < 4; k++) {
+        uint32_t channel = k == 3 ? 255 : (color >> (8 * k)) & 255;
+        source[k] = channel * alpha + 128;
+    }
+
+    int i = 0;
+#ifdef __SSE2__
+    __m128i zero = _mm_setzero_si128();
+    __m128i premultiplied = _mm_setr_epi16((short)source[0], (short)source[1], (short)source[2], (short)source[3],
+                                           (short)source[0], (short)source[1], (short)source[2], (short)source[3]);
+    __m128i inverseAlpha = _mm_set1_epi16((short)inverse);
+    for (; i + 4 <= n; i += 4) {
+        __m128i pixels = _mm_loadu_si128((const __m128i *)(row + i));
+        __m128i low = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(pixels, zero), inverseAlpha), premultiplied);
+        __m128i high = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(pixels, zero), inverseAlpha), premultiplied);
+        low = _mm_srli_epi16(_mm_add_epi16(low, _mm_srli_epi16(low, 8)), 8);
+        high = _mm_srli_epi16(_mm_add_epi16(high, _mm_srli_epi16(high, 8)), 8);
+        _mm_storeu_si128((__m128i *)(row + i), _mm_packus_epi16(low, high));
+    }
+#endif
+    for (; i < n; i++) {
+        uint32_t pixel = row[i], result = 0;
+        for (int k = 0; k < 4; k++) {
+            uint32_t t = ((pixel >> (8 * k)) & 255) * inverse + source[k];
+            result |= ((t + (t >> 8)) >> 8) << (8 * k);
+        }
+        row[i] = result;
+    }
+}
+
+// Pixels [x0, x1) de la ligne y, découpés à l'image
+static void span(Canvas *canvas, int y, int x0, int x1, uint32_t color) {
+    if (y < 0 || y >= canvas->height) return;
+    if (x0 < 0) x0 = 0;
+    if (x1 > canvas->width) x1 = canvas->width;
+    if (x0 >= x1 || color >> 24 == 0) return;
+    uint32_t *row = canvas->pixels + (size_t)y * canvas->stride + x0;
+    if (color >> 24 == 255) fillSpan(row, x1 - x0, color);
+    else blendSpan(row, x1 - x0, color);
+}
+
+// Lignes du rectangle [y, y + h) qui sont dans l'image
+static void clipRows(const Canvas *canvas, int y, int h, int *first, int *end) {
+    *first = y < 0 ? 0 : y;
+    *end = y + h > canvas->height ? canvas->height : y + h;
+}
+
+void rasterFillRect(Canvas *canvas, int x, int y, int w, int h, uint32_t color) {
+    int first, end;
+    clipRows(canvas, y, h, &first, &end);
+    for (int row = first; row < end; row++) {
+        span(canvas, row, x, x + w, color);
+    }
+}
+
+static uint32_t lerpColor(uint32_t from, uint32_t to, int num, int den) {
+    uint32_t result = 0;
+    for (int k = 0; k < 4; k++) {
+        int a = (from >> (8 * k)) & 255, b = (to >> (8 * k)) & 255;
+        result |= (uint32_t)(a + (b - a) * num / den) << (8 * k);
+    }
+    return result;
+}
+
+void rasterGradient(Canvas *canvas, int x, int y, int w, int h, uint32_t top, uint32_t bottom) {
+    int first, end;
+    clipRows(canvas, y, h, &first, &end);
+    for (int row = first; row < end; row++) {
+        span(canvas, row, x, x + w, h > 1 ? lerpColor(top, bottom, row - y, h - 1) : top);
+    }
+}
+
+// Retrait du bord sur la ligne dy (0 = première) : largeur du quart de cercle au centre de
+// la ligne, seulement dans les radius premières et dernières lignes
+static int cornerInset(int dy, int h, int radius) {
+    int fromEdge = dy < h - 1 - dy ? dy : h - 1 - dy;
+    if (fromEdge >= radius) return 0;
+    float v = radius - fromEdge - 0.5f;
+    return radius - (int)(sqrtf((float)(radius * radius) - v * v) + 0.5f);
+}
+
+static int clampRadius(int radius, int w, int h) {
+    if (radius > w / 2) radius = w / 2;
+    if (radius > h / 2) radius = h / 2;
+    return radius < 0 ? 0 : radius;
+}
+
+void rasterFillRoundedRect(Canvas *canvas, int x, int y, int w, int h, int radius, uint32_t color) {
+    radius = clampRadius(radius, w, h);
+    int first, end;
+    clipRows(canvas, y, h, &first, &end);
+    for (int row = first; row < end; row++) {
+        int inset = cornerInset(row - y, h, radius);
+        span(canvas, row, x + inset, x + w - inset, color);
+    }
+}
+
+// Chaque ligne : la forme extérieure moins la forme intérieure (réduite de thickness de
+// chaque côté), soit au plus deux spans
+void rasterStrokeRoundedRect(Canvas *canvas, int x, int y, int w, int h, int radius, int thickness,
+                             uint32_t color) {
+    radius = clampRadius(radius, w, h);
+    int innerW = w - 2 * thickness, innerH = h - 2 * thickness;
+    int innerRadius = clampRadius(radius - thickness, innerW, innerH);
+    int first, end;
+    clipRows(canvas, y, h, &first, &end);
+    for (int row = first; row < end; row++) {
+        int inset = cornerInset(row - y, h, radius);
+        int left = x + inset, right = x + w - inset;
+        int dy = row - y - thickness;
+        if (innerW <= 0 || dy < 0 || dy >= innerH) {
+            span(canvas, row, left, right, color);
+            continue;
+        }
+        int innerInset = cornerInset(dy, innerH, innerRadius);
+        span(canvas, row, left, x + thickness + innerInset, color);
+        span(canvas, row, x + w - thickness - innerInset, right, color);
+    }
+}
@@ -0,0 +1,40 @@
+#ifndef RASTER_H
+#define RASTER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Rastériseur logiciel pour les machines sans rendu accéléré : tout est rempli ligne par
+// ligne (spans) dans une image en mémoire. Pixels 32 bits 0xAARRGGBB
+// (SDL_PIXELFORMAT_ARGB8888) ; une couleur non opaque est mélangée par-dessus, comme
+// SDL_BLENDMODE_BLEND.
+typedef struct {
+    uint32_t *pixels;
+    int width;
+    int height;
+    int stride;         // Pixels par ligne
+} Canvas;
+
+static inline uint32_t rasterColor(uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+    return (uint32_t)a << 24 | (uint32_t)r << 16 | (uint32_t)g << 8 | b;
+}
+
+bool canvasAlloc(Canvas *canvas, int width, int height);
+void canvasFree(Canvas *canvas);
+
+// Copie la partie commune aux deux images
+void canvasCopy(Canvas *dst, const Canvas *src);
+
+// Les formes sont découpées aux bords de l'image ; w et h comptent les pixels couverts
+
+void rasterFillRect(Canvas *canvas, int x, int y, int w, int h, uint32_t color);
+
+// Dégradé vertical, top sur la première ligne et bottom sur la dernière
+void rasterGradient(Canvas *canvas, int x, int y, int w, int h, uint32_t top, uint32_t bottom);
+
+// Coins arrondis de rayon radius (0 : rectangle) ; le contour fait thickness px vers l'intérieur
+void rasterFillRoundedRect(Canvas *canvas, int x, int y, int w, int h, int radius, uint32_t color);
+void rasterStrokeRoundedRect(Canvas *canvas, int x, int y, int w, int h, int radius, int thickness,
+                             uint32_t color);
+
+#endif
@@ -0,0 +1,102 @@
+#include "renderstats.h"
+#include <SDL2/SDL.h>
+#include <stddef.h>
+
+static RenderStats stats;
+
+static SDL_malloc_func sdlMalloc;
+static SDL_calloc_func sdlCalloc;
+static SDL_realloc_func sdlRealloc;
+static SDL_free_func sdlFree;
+
+static void *countMalloc(size_t size) {
+    stats.allocations++;
+    return sdlMalloc(size);
+}
+
+static void *countCalloc(size_t count, size_t size) {
+    stats.allocations++;
+    return sdlCalloc(count, size);
+}
+
+static void *countRealloc(void *ptr, size_t size) {
+    stats.allocations++;
+    return sdlRealloc(ptr, size);
+}
+
+void renderStatsInit(void) {
+    SDL_GetMemoryFunctions(&sdlMalloc, &sdlCalloc, &sdlRealloc, &sdlFree);
+    SDL_SetMemoryFunctions(countMalloc, countCalloc, countRealloc, sdlFree);
+}
+
+RenderStats renderStatsRead(void) {
+    return stats;
+}
+
+// Fonctions interceptées par l'éditeur de liens (--wrap=symbole)
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t count, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+
+void *__wrap_malloc(size_t size) {
+    stats.allocations++;
+    return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t count, size_t size) {
+    stats.allocations++;
+    return __real_calloc(count, size);
+}
+
+void *__wrap_realloc(void *ptr, size_t size) {
+    stats.allocations++;
+    return __real_realloc(ptr, size);
+}
+
+int __real_SDL_RenderClear(SDL_Renderer *renderer);
+int __real_SDL_RenderCopy(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_Rect *src, const SDL_Rect *dst);
+int __real_SDL_RenderFillRect(SDL_Renderer *renderer, const SDL_Rect *rect);
+int __real_SDL_RenderDrawRect(SDL_Renderer *renderer, const SDL_Rect *rect);
+int __real_SDL_RenderDrawLine(SDL_Renderer *renderer, int x1, int y1, int x2, int y2);
+int __real_SDL_RenderDrawPoint(SDL_Renderer *renderer, int x, int y);
+
+int __wrap_SDL_RenderClear(SDL_Renderer *renderer) {
+    stats.drawCalls++;
+    return __real_SDL_RenderClear(renderer);
+}
+
+int __wrap_SDL_RenderCopy(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_Rect *src, const SDL_Rect *dst) {
+    stats.drawCalls++;
+    return __real_SDL_RenderCopy(renderer, texture, src, dst);
+}
+
+int __wrap_SDL_RenderFillRect(SDL_Renderer *renderer, const SDL_Rect *rect) {
+    stats.drawCalls++;
+    return __real_SDL_RenderFillRect(renderer, rect);
+}
+
+int __wrap_SDL_RenderDrawRect(SDL_Renderer *renderer, const SDL_Rect *rect) {
+    stats.drawCalls++;
+    return __real_SDL_RenderDrawRect(renderer, rect);
+}
+
+int __wrap_SDL_RenderDrawLine(SDL_Renderer *renderer, int x1, int y1, int x2, int y2) {
+    stats.drawCalls++;
+    return __real_SDL_RenderDrawLine(renderer, x1, y1, x2, y2);
+}
+
+int __wrap_SDL_RenderDrawPoint(SDL_Renderer *renderer, int x, int y) {
+    stats.drawCalls++;
+    return __real_SDL_RenderDrawPoint(renderer, x, y);
+}
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+int __real_SDL_RenderGeometry(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_Vertex *vertices,
+                              int numVertices, const int *indices, int numIndices);
+
+int __wrap_SDL_RenderGeometry(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_Vertex *vertices,
+                              int numVertices, const int *indices, int numIndices) {
+    stats.drawCalls++;
+    return __real_SDL_RenderGeometry(renderer, texture, vertices, numVertices, indices, numIndices);
+}
+#endif
@@ -0,0 +1,20 @@
+#ifndef RENDERSTATS_H
+#define RENDERSTATS_H
+
+#include <stdint.h>
+
+// Compteurs du banc de rendu (make bench-render), liés seulement dans bench_render.
+// Les appels de dessin SDL_Render* et malloc/calloc/realloc des objets du jeu sont
+// interceptés à l'édition de liens (-Wl,--wrap, voir RENDERSTATS_WRAP dans le Makefile) ;
+// les allocations internes de SDL passent par SDL_SetMemoryFunctions.
+typedef struct {
+    uint64_t drawCalls;
+    uint64_t allocations;
+} RenderStats;
+
+// À appeler avant SDL_Init
+void renderStatsInit(void);
+
+RenderStats renderStatsRead(void);
+
+#endif
@@ -0,0 +1,140 @@
+#include "replay.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+bool replayBegin(Replay *replay, const GameState *game) {
+    PackShape shape;
+    replay->numMoves = 0;
+    memset(&replay->header, 0, sizeof(replay->header));
+    if (!packShapeInit(&shape, game)) return false;
+
+    PileCode codes[MAX_PILES];
+    packFromGame(&shape, game, codes);
+    packBoard(&shape, codes, replay->header.board);
+    memcpy(replay->header.magic, REPLAY_MAGIC, sizeof(replay->header.magic));
+    replay->header.version = REPLAY_VERSION;
+    replay->header.level = (uint8_t)game->currentLevel;
+    replay->header.numPiles = (uint8_t)game->numPiles;
+    replay->header.maxTokens = (uint8_t)game->maxTokens;
+    replay->header.numColors = (uint8_t)game->numColors;
+    replay->header.seed = game->seed;
+    return true;
+}
+
+bool replayRecord(Replay *replay, uint32_t time, int from, int to) {
+    if (replay->numMoves == replay->capMoves) {
+        uint32_t cap = replay->capMoves ? replay->capMoves * 2 : 256;
+        ReplayMove *moves = realloc(replay->moves, cap * sizeof(ReplayMove));
+        if (!moves) return false;
+        replay->moves = moves;
+        replay->capMoves = cap;
+    }
+    replay->moves[replay->numMoves++] = (ReplayMove){time, (uint8_t)from, (uint8_t)to};
+    return true;
+}
+
+static bool writeVarint(FILE *file, uint32_t value) {
+    while (value >= 0x80) {
+        if (fputc((int)(value & 0x7f) | 0x80, file) == EOF) return false;
+        value >>= 7;
+    }
+    return fputc((int)value, file) != EOF;
+}
+
+static bool readVarint(FILE *file, uint32_t *value) {
+    *value = 0;
+    for (int shift = 0; shift < 35; shift += 7) {
+        int byte = fgetc(file);
+        if (byte == EOF) return false;
+        *value |= (uint32_t)(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) return true;
+    }
+    return false;
+}
+
+bool replayWrite(const Replay *replay, const char *path) {
+    FILE *file = fopen(path, "wb");
+    if (!file) return false;
+    bool ok = fwrite(&replay->header, sizeof(replay->header), 1, file) == 1 &&
+              fwrite(&replay->numMoves, sizeof(replay->numMoves), 1, file) == 1;
+    uint32_t previous = 0;
+    for (uint32_t i = 0; ok && i < replay->numMoves; i++) {
+        const ReplayMove *move = &replay->moves[i];
+        ok = writeVarint(file, move->time - previous) &&
+             fputc(move->from, file) != EOF && fputc(move->to, file) != EOF;
+        previous = move->time;
+    }
+    return fclose(file) == 0 && ok;
+}
+
+bool replayRead(Replay *replay, const char *path) {
+    FILE *file = fopen(path, "rb");
+    if (!file) return false;
+
+    uint32_t numMoves;
+    ReplayHeader *header = &replay->header;
+    replay->numMoves = 0;
+    bool ok = fread(header, sizeof(*header), 1, file) == 1 &&
+              fread(&numMoves, sizeof(numMoves), 1, file) == 1 &&
+              memcmp(header->magic, REPLAY_MAGIC, sizeof(header->magic)) == 0 &&
+              header->version == REPLAY_VERSION &&
+              header->level >= LEVEL_EASY && header->level <= LEVEL_CUSTOM &&
+              isValidShape(header->numPiles, header->maxTokens, header->numColors) &&
+              header->numPiles <= PACK_MAX_PILES && header->maxTokens <= PACK_MAX_TOKENS &&
+              header->numColors <= PACK_MAX_COLORS;
+
+    uint32_t time = 0;
+    for (uint32_t i = 0; ok && i < numMoves; i++) {
+        uint32_t delta;
+        int from, to;
+        ok = readVarint(file, &delta) && (from = fgetc(file)) != EOF && (to = fgetc(file)) != EOF &&
+             from < header->numPiles && to < header->numPiles;
+        time += delta;
+        ok = ok && replayRecord(replay, time, from, to);
+    }
+    fclose(file);
+    return ok;
+}
+
+void replayFree(Replay *replay) {
+    free(replay->moves);
+    memset(replay, 0, sizeof(*replay));
+}
+
+void replayStart(const Replay *replay, GameState *game) {
+    game->numPiles = replay->header.numPiles;
+    game->maxTokens = replay->header.maxTokens;
+    game->numColors = replay->header.numColors;
+    game->currentLevel = (DifficultyLevel)replay->header.level;
+    game->seed = replay->header.seed;
+    game->selected = -1;
+    game->status = GAME_PLAYING;
+    game->moveCount = 0;
+
+    PackShape shape;
+    packShapeInit(&shape, game);
+    PileCode codes[MAX_PILES];
+    unpackBoard(&shape, replay->header.board, codes);
+    for (int i = 0; i < MAX_PILES; i++) {
+        game->piles[i].count = 0;
+    }
+    packToGame(&shape, codes, game);
+}
+
+int replayRun(const Replay *replay, GameState *game, bool *won) {
+    replayStart(replay, game);
+    for (uint32_t i = 0; i < replay->numMoves; i++) {
+        const ReplayMove *move = &replay->moves[i];
+        if (!canMoveToken(game, move->from, move->to)) {
+            *won = false;
+            return -1 - (int)i;
+        }
+        moveToken(game, move->from, move->to);
+        game->moveCount++;
+        // Même vérification qu'après chaque coup dans le jeu
+        if (checkWin(game)) game->status = GAME_WON;
+    }
+    *won = game->status == GAME_WON;
+    return (int)replay->numMoves;
+}
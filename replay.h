@@ -0,0 +1,62 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "boardpack.h"
+#include "game.h"
+
+// Enregistrement d'une partie : graine, plateau de départ (boardpack) et coups datés.
+// Fichier : en-tête | nombre de coups | par coup, écart en ms depuis le coup précédent
+// (entier variable sur 7 bits par octet) puis pile source et destination sur un octet.
+// Entiers de l'en-tête en petit-boutiste (ordre natif des machines visées).
+#define REPLAY_MAGIC "NUTSRPLY"
+#define REPLAY_VERSION 1
+#define REPLAY_DEFAULT_PATH "last-game.replay"
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint8_t level;
+    uint8_t numPiles;
+    uint8_t maxTokens;
+    uint8_t numColors;
+    uint64_t seed;
+    uint64_t board[PACK_MAX_WORDS];
+} ReplayHeader;
+
+typedef struct {
+    uint32_t time;      // ms depuis le début de la partie
+    uint8_t from;
+    uint8_t to;
+} ReplayMove;
+
+typedef struct {
+    ReplayHeader header;
+    ReplayMove *moves;
+    uint32_t numMoves;
+    uint32_t capMoves;
+} Replay;
+
+// Commence l'enregistrement d'une partie sur le plateau de départ de game ;
+// false si le plateau ne tient pas dans l'en-tête
+bool replayBegin(Replay *replay, const GameState *game);
+
+bool replayRecord(Replay *replay, uint32_t time, int from, int to);
+
+bool replayWrite(const Replay *replay, const char *path);
+
+// Remplace le contenu de replay ; false si le fichier est illisible ou incohérent
+bool replayRead(Replay *replay, const char *path);
+
+void replayFree(Replay *replay);
+
+// Remet le plateau de départ, le niveau et la graine dans game
+void replayStart(const Replay *replay, GameState *game);
+
+// Rejoue tous les coups depuis le plateau de départ par canMoveToken/moveToken, sans rendu.
+// checkWin est appelé après chaque coup. Retourne le nombre de coups joués, ou -1 - i si le
+// coup i est illégal ; *won indique si la partie a été gagnée.
+int replayRun(const Replay *replay, GameState *game, bool *won);
+
+#endif
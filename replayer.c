@@ -0,0 +1,71 @@
+// Lecteur de parties enregistrées, sans rendu : rejoue chaque fichier à pleine vitesse
+// Usage : replayer [-n répétitions] fichier...
+#include "replay.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int main(int argc, char *argv[]) {
+    int repeats = 1;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "n:")) != -1) {
+        switch (opt) {
+            case 'n': repeats = atoi(optarg); break;
+            default:
+                fprintf(stderr, "Usage: %s [-n répétitions] fichier...\n", argv[0]);
+                return 1;
+        }
+    }
+    if (optind == argc) {
+        fprintf(stderr, "Usage: %s [-n répétitions] fichier...\n", argv[0]);
+        return 1;
+    }
+    if (repeats < 1) repeats = 1;
+
+    int failures = 0;
+    uint64_t totalMoves = 0;
+    double start = now();
+    for (int f = optind; f < argc; f++) {
+        Replay replay = {0};
+        if (!replayRead(&replay, argv[f])) {
+            fprintf(stderr, "%s : fichier illisible ou corrompu\n", argv[f]);
+            failures++;
+            replayFree(&replay);
+            continue;
+        }
+
+        GameState game;
+        bool won = false;
+        int played = 0;
+        double fileStart = now();
+        for (int r = 0; r < repeats; r++) {
+            played = replayRun(&replay, &game, &won);
+            if (played < 0) break;
+            totalMoves += (uint64_t)played;
+        }
+        double elapsed = now() - fileStart;
+
+        if (played < 0) {
+            printf("%s : coup %d illégal\n", argv[f], -1 - played);
+            failures++;
+        } else {
+            printf("%s : niveau %d, graine %llu, %d coups en %u ms, %s (%.0f coups/s)\n",
+                   argv[f], replay.header.level, (unsigned long long)replay.header.seed, played,
+                   replay.numMoves ? replay.moves[replay.numMoves - 1].time : 0,
+                   won ? "gagné" : "non gagné", elapsed > 0 ? played * (double)repeats / elapsed : 0.0);
+        }
+        replayFree(&replay);
+    }
+
+    double elapsed = now() - start;
+    printf("%llu coups rejoués en %.3f s\n", (unsigned long long)totalMoves, elapsed);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,203 @@
+#include "simdkernel.h"
+#include <string.h>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#define SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+void byteBoardFromGame(const GameState *game, ByteBoard *board) {
+    memset(board, 0, sizeof(*board));
+    board->numPiles = game->numPiles;
+    board->maxTokens = game->maxTokens;
+    for (int p = 0; p < game->numPiles; p++) {
+        const Pile *pile = &game->piles[p];
+        board->count[p] = (uint8_t)pile->count;
+        for (int t = 0; t < pile->count; t++) {
+            board->cells[p][t] = (uint8_t)(pile->colors[t] + 1);
+        }
+    }
+}
+
+static inline uint32_t fullRowMask(const ByteBoard *board) {
+    return (1u << board->maxTokens) - 1;
+}
+
+// Scalaire : la référence des versions vectorielles
+
+static uint64_t sortedMaskScalar(const ByteBoard *board) {
+    uint64_t mask = 0;
+    for (int p = 0; p < board->numPiles; p++) {
+        const uint8_t *row = board->cells[p];
+        bool sorted = true;
+        for (int t = 1; t < board->maxTokens; t++) {
+            sorted &= row[t] == row[0];
+        }
+        mask |= (uint64_t)sorted << p;
+    }
+    return mask;
+}
+
+static uint64_t openMaskScalar(const ByteBoard *board) {
+    uint64_t mask = 0;
+    for (int p = 0; p < board->numPiles; p++) {
+        mask |= (uint64_t)(board->count[p] < board->maxTokens) << p;
+    }
+    return mask;
+}
+
+static uint64_t nonEmptyMaskScalar(const ByteBoard *board) {
+    uint64_t mask = 0;
+    for (int p = 0; p < board->numPiles; p++) {
+        mask |= (uint64_t)(board->count[p] > 0) << p;
+    }
+    return mask;
+}
+
+static void topTokensScalar(const ByteBoard *board, uint8_t *tops) {
+    for (int p = 0; p < board->numPiles; p++) {
+        int count = board->count[p];
+        tops[p] = count ? board->cells[p][count - 1] : 0;
+    }
+}
+
+#ifdef SIMD_X86
+
+// SSE2 (toujours présent en x86-64) : une pile par registre. Les cases au-delà du
+// nombre de jetons valent 0 : une pile est triée si ses maxTokens premières cases sont
+// égales à la première (pleine d'une couleur, ou vide).
+static uint64_t sortedMaskSse2(const ByteBoard *board) {
+    uint32_t full = fullRowMask(board);
+    uint64_t mask = 0;
+    for (int p = 0; p < board->numPiles; p++) {
+        __m128i row = _mm_loadu_si128((const __m128i *)board->cells[p]);
+        __m128i first = _mm_set1_epi8((char)board->cells[p][0]);
+        uint32_t equal = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(row, first));
+        mask |= (uint64_t)((equal & full) == full) << p;
+    }
+    return mask;
+}
+
+// Compteurs : 16 piles par comparaison
+static uint64_t openMaskSse2(const ByteBoard *board) {
+    __m128i limit = _mm_set1_epi8((char)board->maxTokens);
+    uint64_t mask = 0;
+    for (int p = 0; p < board->numPiles; p += 16) {
+        __m128i count = _mm_loadu_si128((const __m128i *)&board->count[p]);
+        mask |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmplt_epi8(count, limit)) << p;
+    }
+    return mask & bytePileMask(board);
+}
+
+static uint64_t nonEmptyMaskSse2(const ByteBoard *board) {
+    __m128i zero = _mm_setzero_si128();
+    uint64_t mask = 0;
+    for (int p = 0; p < board->numPiles; p += 16) {
+        __m128i count = _mm_loadu_si128((const __m128i *)&board->count[p]);
+        mask |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpgt_epi8(count, zero)) << p;
+    }
+    return mask & bytePileMask(board);
+}
+
+// AVX2 : deux piles par registre, le premier jeton diffusé dans chaque moitié par pshufb
+__attribute__((target("avx2")))
+static uint64_t sortedMaskAvx2(const ByteBoard *board) {
+    uint32_t full = fullRowMask(board);
+    __m256i broadcast = _mm256_setzero_si256();
+    uint64_t mask = 0;
+    for (int p = 0; p < board->numPiles; p += 2) {
+        __m256i rows = _mm256_loadu_si256((const __m256i *)board->cells[p]);
+        __m256i first = _mm256_shuffle_epi8(rows, broadcast);
+        uint32_t equal = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(rows, first));
+        mask |= (uint64_t)((equal & full) == full) << p;
+        mask |= (uint64_t)(((equal >> 16) & full) == full) << (p + 1);
+    }
+    return mask & bytePileMask(board);
+}
+
+__attribute__((target("avx2")))
+static uint64_t openMaskAvx2(const ByteBoard *board) {
+    __m256i limit = _mm256_set1_epi8((char)board->maxTokens);
+    uint64_t mask = 0;
+    for (int p = 0; p < board->numPiles; p += 32) {
+        __m256i count = _mm256_loadu_si256((const __m256i *)&board->count[p]);
+        mask |= (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpgt_epi8(limit, count)) << p;
+    }
+    return mask & bytePileMask(board);
+}
+
+__attribute__((target("avx2")))
+static uint64_t nonEmptyMaskAvx2(const ByteBoard *board) {
+    __m256i zero = _mm256_setzero_si256();
+    uint64_t mask = 0;
+    for (int p = 0; p < board->numPiles; p += 32) {
+        __m256i count = _mm256_loadu_si256((const __m256i *)&board->count[p]);
+        mask |= (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpgt_epi8(count, zero)) << p;
+    }
+    return mask & bytePileMask(board);
+}
+
+// Huit sommets par lecture groupée : octet count - 1 de chaque ligne (0 si la pile est
+// vide, la case 0 valant alors 0). Écrit jusqu'au multiple de 8 suivant numPiles.
+__attribute__((target("avx2")))
+static void topTokensAvx2(const ByteBoard *board, uint8_t *tops) {
+    const __m128i one = _mm_set1_epi8(1);
+    const __m256i rows = _mm256_setr_epi32(0, 16, 32, 48, 64, 80, 96, 112);
+    const __m256i lowByte = _mm256_setr_epi8(0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                             0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+    const __m256i joinLanes = _mm256_setr_epi32(0, 4, 1, 1, 1, 1, 1, 1);
+    const int *base = (const int *)(const void *)board->cells[0];
+    for (int p = 0; p < board->numPiles; p += 8) {
+        __m128i last = _mm_subs_epu8(_mm_loadl_epi64((const __m128i *)&board->count[p]), one);
+        __m256i offset = _mm256_add_epi32(_mm256_cvtepu8_epi32(last),
+                                          _mm256_add_epi32(rows, _mm256_set1_epi32(p * MAX_TOKENS)));
+        __m256i cells = _mm256_i32gather_epi32(base, offset, 1);
+        __m256i packed = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(cells, lowByte), joinLanes);
+        _mm_storel_epi64((__m128i *)&tops[p], _mm256_castsi256_si128(packed));
+    }
+}
+
+#endif
+
+static const SimdKernel kernels[] = {
+    {"scalar", sortedMaskScalar, openMaskScalar, nonEmptyMaskScalar, topTokensScalar},
+#ifdef SIMD_X86
+    // Pas de lecture groupée en SSE2 : les sommets restent scalaires
+    {"sse2", sortedMaskSse2, openMaskSse2, nonEmptyMaskSse2, topTokensScalar},
+    {"avx2", sortedMaskAvx2, openMaskAvx2, nonEmptyMaskAvx2, topTokensAvx2},
+#endif
+};
+
+int simdKernelCount(void) {
+#ifdef SIMD_X86
+    return __builtin_cpu_supports("avx2") ? 3 : 2;
+#else
+    return 1;
+#endif
+}
+
+const SimdKernel *simdKernelAt(int index) {
+    return &kernels[index];
+}
+
+const SimdKernel *simdKernel(void) {
+    return &kernels[simdKernelCount() - 1];
+}
+
+int simdGenerateMoves(const SimdKernel *kernel, const ByteBoard *board, KernelMove *moves) {
+    uint64_t sources = kernel->nonEmptyMask(board);
+    uint64_t open = kernel->openMask(board);
+    int n = 0;
+    while (sources) {
+        int from = __builtin_ctzll(sources);
+        sources &= sources - 1;
+        uint64_t targets = open & ~(1ull << from);
+        while (targets) {
+            moves[n].from = (unsigned char)from;
+            moves[n].to = (unsigned char)__builtin_ctzll(targets);
+            targets &= targets - 1;
+            n++;
+        }
+    }
+    return n;
+}
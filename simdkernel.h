@@ -0,0 +1,57 @@
+#ifndef SIMDKERNEL_H
+#define SIMDKERNEL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "game.h"
+
+// Plateau en octets pour les noyaux vectoriels : une ligne de MAX_TOKENS (16) octets par
+// pile, soit un registre SSE, couleur + 1 par case et 0 pour une case vide. Les lignes
+// au-delà de numPiles restent vides. count suit cells : les lectures groupées de la
+// dernière ligne restent dans la structure.
+typedef struct {
+    uint8_t cells[MAX_PILES][MAX_TOKENS];
+    uint8_t count[MAX_PILES];
+    int numPiles;
+    int maxTokens;
+} ByteBoard;
+
+#define SIMD_MAX_MOVES (MAX_PILES * (MAX_PILES - 1))
+
+typedef struct {
+    unsigned char from;
+    unsigned char to;
+} KernelMove;
+
+// Chaque fonction traite toutes les piles à la fois ; bit p du masque pour la pile p
+typedef struct {
+    const char *name;
+    uint64_t (*sortedMask)(const ByteBoard *board);     // Vide ou pleine d'une couleur
+    uint64_t (*openMask)(const ByteBoard *board);       // Moins de maxTokens jetons
+    uint64_t (*nonEmptyMask)(const ByteBoard *board);
+    // tops : MAX_PILES octets, couleur + 1 du jeton du haut (0 pour une pile vide)
+    void (*topTokens)(const ByteBoard *board, uint8_t *tops);
+} SimdKernel;
+
+void byteBoardFromGame(const GameState *game, ByteBoard *board);
+
+// Meilleur noyau pris en charge par le processeur (AVX2, SSE2, sinon scalaire)
+const SimdKernel *simdKernel(void);
+
+// Noyaux utilisables sur ce processeur, le scalaire en premier (bancs et vérifications)
+int simdKernelCount(void);
+const SimdKernel *simdKernelAt(int index);
+
+static inline uint64_t bytePileMask(const ByteBoard *board) {
+    return board->numPiles == 64 ? ~0ull : (1ull << board->numPiles) - 1;
+}
+
+// Même résultat que checkWinScan
+static inline bool simdCheckWin(const SimdKernel *kernel, const ByteBoard *board) {
+    return kernel->sortedMask(board) == bytePileMask(board);
+}
+
+// Tous les coups acceptés par canMoveToken ; retourne leur nombre (au plus SIMD_MAX_MOVES)
+int simdGenerateMoves(const SimdKernel *kernel, const ByteBoard *board, KernelMove *moves);
+
+#endif
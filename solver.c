@@ -0,0 +1,201 @@
+#include "solver.h"
+#include "boardpack.h"
+#include "transtable.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Les plateaux sont stockés sous forme canonique compacte (boards, `shape.words` mots
+// par nœud) ; un nœud ne garde que son parent et sa profondeur.
+typedef struct {
+    uint32_t parent;
+    uint32_t g;
+} SolverNode;
+
+typedef struct {
+    int f;
+    int g;
+    uint32_t node;
+} HeapEntry;
+
+typedef struct {
+    PackShape shape;
+
+    SolverNode *nodes;
+    uint64_t *boards;
+    size_t numNodes;
+    size_t capNodes;
+
+    TransTable table;    // Plateau canonique -> indice du nœud
+
+    HeapEntry *heap;
+    size_t heapSize;
+    size_t heapCap;
+} Solver;
+
+#define NO_PARENT UINT32_MAX
+
+static bool growNodes(Solver *s) {
+    size_t cap = s->capNodes ? s->capNodes * 2 : 4096;
+    SolverNode *nodes = realloc(s->nodes, cap * sizeof(SolverNode));
+    if (!nodes) return false;
+    s->nodes = nodes;
+    uint64_t *boards = realloc(s->boards, cap * s->shape.words * sizeof(uint64_t));
+    if (!boards) return false;
+    s->boards = boards;
+    s->capNodes = cap;
+    return true;
+}
+
+static bool heapLess(const HeapEntry *a, const HeapEntry *b) {
+    // À f égal, explorer d'abord les nœuds les plus profonds
+    return a->f < b->f || (a->f == b->f && a->g > b->g);
+}
+
+static bool heapPush(Solver *s, HeapEntry entry) {
+    if (s->heapSize == s->heapCap) {
+        size_t cap = s->heapCap ? s->heapCap * 2 : 4096;
+        HeapEntry *heap = realloc(s->heap, cap * sizeof(HeapEntry));
+        if (!heap) return false;
+        s->heap = heap;
+        s->heapCap = cap;
+    }
+    size_t i = s->heapSize++;
+    while (i > 0) {
+        size_t parent = (i - 1) / 2;
+        if (!heapLess(&entry, &s->heap[parent])) break;
+        s->heap[i] = s->heap[parent];
+        i = parent;
+    }
+    s->heap[i] = entry;
+    return true;
+}
+
+static HeapEntry heapPop(Solver *s) {
+    HeapEntry top = s->heap[0];
+    HeapEntry last = s->heap[--s->heapSize];
+    size_t i = 0;
+    for (;;) {
+        size_t child = 2 * i + 1;
+        if (child >= s->heapSize) break;
+        if (child + 1 < s->heapSize && heapLess(&s->heap[child + 1], &s->heap[child])) child++;
+        if (!heapLess(&s->heap[child], &last)) break;
+        s->heap[i] = s->heap[child];
+        i = child;
+    }
+    if (s->heapSize > 0) s->heap[i] = last;
+    return top;
+}
+
+// Ajoute (ou améliore) un état ; retourne false en cas d'échec d'allocation
+static bool pushBoard(Solver *s, const PileCode *codes, uint32_t parent, int g) {
+    uint64_t key[PACK_MAX_WORDS];
+    packCanonical(&s->shape, codes, key, NULL);
+
+    bool found;
+    uint32_t *value = ttInsert(&s->table, key, packHash(key, s->shape.words), &found);
+    if (!value) return false;
+
+    uint32_t index;
+    if (found) {
+        // Réouverture si un chemin plus court est trouvé (heuristique non cohérente)
+        index = *value;
+        if ((uint32_t)g >= s->nodes[index].g) return true;
+    } else {
+        if (s->numNodes == s->capNodes && !growNodes(s)) return false;
+        index = (uint32_t)s->numNodes++;
+        memcpy(&s->boards[index * s->shape.words], key, s->shape.words * sizeof(uint64_t));
+        *value = index;
+    }
+    s->nodes[index].parent = parent;
+    s->nodes[index].g = (uint32_t)g;
+
+    HeapEntry entry = {g + packHeuristic(&s->shape, codes), g, index};
+    return heapPush(s, entry);
+}
+
+// Les nœuds sont canoniques : retrouver les coups dans la numérotation réelle des piles
+static void buildSolution(const Solver *s, uint32_t goal, const PileCode *start, SolverResult *result) {
+    int length = (int)s->nodes[goal].g;
+    const uint64_t *path[SOLVER_MAX_MOVES + 1];
+    for (int i = length; i >= 0; i--) {
+        path[i] = &s->boards[goal * s->shape.words];
+        goal = s->nodes[goal].parent;
+    }
+
+    unsigned char from[SOLVER_MAX_MOVES], to[SOLVER_MAX_MOVES];
+    result->solved = packTracePath(&s->shape, start, path, length, from, to);
+    for (int i = 0; i < length; i++) {
+        result->moves[i].from = from[i];
+        result->moves[i].to = to[i];
+    }
+    result->numMoves = length;
+}
+
+bool solveGame(const GameState *game, size_t maxNodes, SolverResult *result) {
+    return solveGameCancellable(game, maxNodes, NULL, result);
+}
+
+bool solveGameCancellable(const GameState *game, size_t maxNodes, const atomic_bool *cancel, SolverResult *result) {
+    memset(result, 0, sizeof(*result));
+    if (maxNodes == 0) maxNodes = SOLVER_DEFAULT_MAX_NODES;
+
+    Solver s = {0};
+    if (!packShapeInit(&s.shape, game)) return false;
+
+    PileCode start[MAX_PILES];
+    packFromGame(&s.shape, game, start);
+
+    bool ok = ttInit(&s.table, s.shape.words, 8192) && pushBoard(&s, start, NO_PARENT, 0);
+
+    while (ok && s.heapSize > 0) {
+        HeapEntry entry = heapPop(&s);
+        if ((uint32_t)entry.g != s.nodes[entry.node].g) continue;  // Entrée périmée
+
+        if (entry.f == entry.g) {
+            // h == 0 équivaut à checkWin
+            buildSolution(&s, entry.node, start, result);
+            break;
+        }
+        if (s.numNodes >= maxNodes || entry.g >= SOLVER_MAX_MOVES) break;
+        result->nodesExpanded++;
+        if (cancel && (result->nodesExpanded & (SOLVER_CANCEL_INTERVAL - 1)) == 0 &&
+            atomic_load_explicit(cancel, memory_order_relaxed)) {
+            break;
+        }
+
+        PileCode codes[MAX_PILES];
+        unpackBoard(&s.shape, &s.boards[entry.node * s.shape.words], codes);
+
+        for (int from = 0; from < s.shape.numPiles && ok; from++) {
+            int srcCount = pileCount(codes[from]);
+            if (srcCount == 0) continue;
+            bool emptyTried = false;
+
+            for (int to = 0; to < s.shape.numPiles; to++) {
+                int destCount = pileCount(codes[to]);
+                if (to == from || destCount >= s.shape.maxTokens) continue;
+                if (destCount == 0) {
+                    // Les piles vides sont interchangeables ; déplacer un jeton seul ne change rien
+                    if (emptyTried || srcCount == 1) continue;
+                    emptyTried = true;
+                }
+
+                PileCode child[MAX_PILES];
+                memcpy(child, codes, s.shape.numPiles * sizeof(PileCode));
+                child[to] = pilePush(child[to], pileTopCell(child[from]));
+                child[from] = pilePop(child[from]);
+
+                ok = pushBoard(&s, child, entry.node, entry.g + 1);
+                if (!ok) break;
+            }
+        }
+    }
+
+    result->nodesStored = s.numNodes;
+    free(s.nodes);
+    free(s.boards);
+    free(s.heap);
+    ttFree(&s.table);
+    return result->solved;
+}
@@ -0,0 +1,39 @@
+#ifndef SOLVER_H
+#define SOLVER_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "game.h"
+
+#define SOLVER_MAX_MOVES 128
+#define SOLVER_DEFAULT_MAX_NODES 4000000
+#define SOLVER_CANCEL_INTERVAL 1024     // Nœuds développés entre deux lectures de cancel
+
+typedef struct {
+    unsigned char from;
+    unsigned char to;
+} SolverMove;
+
+typedef struct {
+    bool solved;
+    int numMoves;                       // Nombre minimal de coups (si solved)
+    SolverMove moves[SOLVER_MAX_MOVES];  // Solution : moves[0] est le meilleur coup suivant
+    size_t nodesExpanded;
+    size_t nodesStored;
+} SolverResult;
+
+// Recherche A* d'une solution en un nombre minimal de coups, sans SDL.
+// maxNodes borne la mémoire utilisée (0 = SOLVER_DEFAULT_MAX_NODES) ;
+// retourne false si le plateau est insoluble ou si la borne est atteinte.
+bool solveGame(const GameState *game, size_t maxNodes, SolverResult *result);
+
+// Même recherche, abandonnée (retour false) dès que *cancel devient vrai
+bool solveGameCancellable(const GameState *game, size_t maxNodes, const atomic_bool *cancel, SolverResult *result);
+
+// Même résultat (nombre minimal de coups) en répartissant la recherche sur numThreads
+// workers (0 = un par cœur) qui partagent une table des états visités sans verrou.
+// Destiné aux grands plateaux et à l'évaluation en lot ; maxNodes dimensionne la table.
+bool solveGameParallel(const GameState *game, int numThreads, size_t maxNodes, SolverResult *result);
+
+#endif
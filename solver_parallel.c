@@ -0,0 +1,373 @@
+#include "solver.h"
+#include "boardpack.h"
+#include "transtable.h"
+#include <limits.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// Recherche parallèle en largeur bornée (BFIDA*) : chaque couche de profondeur est
+// développée par tous les workers, en ne gardant que les états tels que g + h <= borne.
+// La première couche qui contient un état gagnant donne une solution minimale, comme
+// l'A* séquentiel. Si aucune couche n'en contient, la borne augmente et on recommence.
+
+#define STEAL_CHUNK 64      // Nœuds réservés d'un coup dans une plage (la sienne ou celle d'un autre)
+#define COUNT_BATCH 256     // Fréquence de mise à jour du compteur global de nœuds
+#define MAX_THREADS 256
+
+typedef struct {
+    uint64_t *boards;       // Plateaux canoniques, `words` mots par nœud
+    uint32_t *parents;
+    size_t count;
+    size_t cap;
+} NodeList;
+
+// Plage de nœuds de la couche courante attribuée à un worker ; les autres workers
+// viennent y prendre des paquets lorsqu'ils ont épuisé la leur.
+typedef struct {
+    _Atomic size_t next;
+    size_t end;
+} __attribute__((aligned(64))) WorkRange;
+
+typedef struct ParallelSearch ParallelSearch;
+
+typedef struct {
+    ParallelSearch *search;
+    int id;
+    NodeList out;           // Enfants produits pendant la couche
+    long goal;              // Indice d'un état gagnant dans out, -1 sinon
+    size_t offset;          // Position de out dans la liste globale après fusion
+    size_t pending;         // Nœuds pas encore reportés dans search->stored
+    size_t expanded;
+    int nextBound;          // Plus petit g + h élagué, candidat pour la borne suivante
+    pthread_t thread;
+} Worker;
+
+struct ParallelSearch {
+    PackShape shape;
+    SharedTransTable table;
+    NodeList nodes;         // Toutes les couches de la passe courante
+    int bound;
+    int depth;
+    size_t maxNodes;
+
+    int numThreads;
+    Worker *workers;
+    WorkRange *ranges;
+    pthread_barrier_t barrier;
+    _Atomic bool ready;     // Barrière initialisée
+    bool done;
+
+    _Atomic size_t stored;
+    _Atomic bool stop;      // État gagnant trouvé ou borne mémoire atteinte
+    _Atomic bool failed;
+};
+
+static bool appendNode(NodeList *list, int words, const uint64_t *board, uint32_t parent) {
+    if (list->count == list->cap) {
+        size_t cap = list->cap ? list->cap * 2 : 1024;
+        uint64_t *boards = realloc(list->boards, cap * words * sizeof(uint64_t));
+        if (!boards) return false;
+        list->boards = boards;
+        uint32_t *parents = realloc(list->parents, cap * sizeof(uint32_t));
+        if (!parents) return false;
+        list->parents = parents;
+        list->cap = cap;
+    }
+    memcpy(&list->boards[list->count * words], board, words * sizeof(uint64_t));
+    list->parents[list->count++] = parent;
+    return true;
+}
+
+static void freeNodes(NodeList *list) {
+    free(list->boards);
+    free(list->parents);
+}
+
+static void countNode(Worker *w) {
+    ParallelSearch *ps = w->search;
+    if (++w->pending < COUNT_BATCH) return;
+    size_t total = atomic_fetch_add_explicit(&ps->stored, w->pending, memory_order_relaxed) + w->pending;
+    w->pending = 0;
+    if (total >= ps->maxNodes) {
+        atomic_store(&ps->failed, true);
+        atomic_store(&ps->stop, true);
+    }
+}
+
+static void expandNode(Worker *w, size_t index) {
+    ParallelSearch *ps = w->search;
+    const PackShape *shape = &ps->shape;
+    PileCode codes[MAX_PILES];
+    unpackBoard(shape, &ps->nodes.boards[index * shape->words], codes);
+    w->expanded++;
+
+    for (int from = 0; from < shape->numPiles; from++) {
+        int srcCount = pileCount(codes[from]);
+        if (srcCount == 0) continue;
+        bool emptyTried = false;
+
+        for (int to = 0; to < shape->numPiles; to++) {
+            int destCount = pileCount(codes[to]);
+            if (to == from || destCount >= shape->maxTokens) continue;
+            if (destCount == 0) {
+                // Les piles vides sont interchangeables ; déplacer un jeton seul ne change rien
+                if (emptyTried || srcCount == 1) continue;
+                emptyTried = true;
+            }
+
+            PileCode child[MAX_PILES];
+            memcpy(child, codes, shape->numPiles * sizeof(PileCode));
+            child[to] = pilePush(child[to], pileTopCell(child[from]));
+            child[from] = pilePop(child[from]);
+
+            int h = packHeuristic(shape, child);
+            int f = ps->depth + 1 + h;
+            if (f > ps->bound) {
+                if (f < w->nextBound) w->nextBound = f;
+                continue;
+            }
+
+            uint64_t key[PACK_MAX_WORDS];
+            packCanonical(shape, child, key, NULL);
+            SharedInsertResult inserted = sttInsert(&ps->table, key, packHash(key, shape->words));
+            if (inserted == STT_FOUND) continue;
+            if (inserted == STT_FULL || !appendNode(&w->out, shape->words, key, (uint32_t)index)) {
+                atomic_store(&ps->failed, true);
+                atomic_store(&ps->stop, true);
+                return;
+            }
+            countNode(w);
+
+            if (h == 0) {
+                w->goal = (long)w->out.count - 1;
+                atomic_store(&ps->stop, true);
+                return;
+            }
+        }
+    }
+}
+
+// Développer sa propre plage puis voler des paquets dans celles des autres workers
+static void expandLayer(Worker *w) {
+    ParallelSearch *ps = w->search;
+    for (int k = 0; k < ps->numThreads; k++) {
+        WorkRange *range = &ps->ranges[(w->id + k) % ps->numThreads];
+        for (;;) {
+            if (atomic_load_explicit(&ps->stop, memory_order_relaxed)) return;
+            size_t begin = atomic_fetch_add_explicit(&range->next, STEAL_CHUNK, memory_order_relaxed);
+            if (begin >= range->end) break;
+            size_t end = begin + STEAL_CHUNK < range->end ? begin + STEAL_CHUNK : range->end;
+            for (size_t i = begin; i < end; i++) {
+                expandNode(w, i);
+            }
+        }
+    }
+}
+
+// Chaque worker recopie ses enfants dans la liste globale, à l'offset préparé par le
+// coordinateur : la fusion des couches ne passe pas par un seul thread
+static void copyLayerOut(Worker *w) {
+    ParallelSearch *ps = w->search;
+    int words = ps->shape.words;
+    memcpy(&ps->nodes.boards[w->offset * words], w->out.boards, w->out.count * words * sizeof(uint64_t));
+    memcpy(&ps->nodes.parents[w->offset], w->out.parents, w->out.count * sizeof(uint32_t));
+    w->out.count = 0;
+}
+
+static void *workerMain(void *arg) {
+    Worker *w = arg;
+    ParallelSearch *ps = w->search;
+    while (!atomic_load(&ps->ready)) {
+        sched_yield();
+    }
+    for (;;) {
+        pthread_barrier_wait(&ps->barrier);   // Début de couche
+        if (ps->done) break;
+        expandLayer(w);
+        pthread_barrier_wait(&ps->barrier);   // Fin du développement
+        pthread_barrier_wait(&ps->barrier);   // Offsets prêts
+        copyLayerOut(w);
+        pthread_barrier_wait(&ps->barrier);   // Fin de la recopie
+    }
+    return NULL;
+}
+
+static void splitLayer(ParallelSearch *ps, size_t begin, size_t end) {
+    size_t size = end - begin;
+    for (int t = 0; t < ps->numThreads; t++) {
+        atomic_store(&ps->ranges[t].next, begin + size * t / ps->numThreads);
+        ps->ranges[t].end = begin + size * (t + 1) / ps->numThreads;
+    }
+}
+
+// Réserver la place des enfants de chaque worker dans la liste globale ;
+// retourne l'indice global d'un état gagnant ou -1
+static long prepareMerge(ParallelSearch *ps) {
+    long goal = -1;
+    size_t total = ps->nodes.count;
+    for (int t = 0; t < ps->numThreads; t++) {
+        Worker *w = &ps->workers[t];
+        w->offset = total;
+        if (w->goal >= 0 && goal < 0) goal = (long)(total + w->goal);
+        w->goal = -1;
+        total += w->out.count;
+    }
+
+    NodeList *nodes = &ps->nodes;
+    if (total > nodes->cap) {
+        size_t cap = nodes->cap ? nodes->cap : 1024;
+        while (cap < total) cap *= 2;
+        uint64_t *boards = realloc(nodes->boards, cap * ps->shape.words * sizeof(uint64_t));
+        uint32_t *parents = boards ? realloc(nodes->parents, cap * sizeof(uint32_t)) : NULL;
+        if (boards) nodes->boards = boards;
+        if (parents) nodes->parents = parents;
+        if (!boards || !parents) {
+            // Rien n'est recopié : les workers vident seulement leur tampon
+            atomic_store(&ps->failed, true);
+            for (int t = 0; t < ps->numThreads; t++) ps->workers[t].out.count = 0;
+            return -1;
+        }
+        nodes->cap = cap;
+    }
+    nodes->count = total;
+    return goal;
+}
+
+static bool buildSolution(const ParallelSearch *ps, long goal, const PileCode *start, SolverResult *result) {
+    int length = ps->depth + 1;
+    const uint64_t *path[SOLVER_MAX_MOVES + 1];
+    uint32_t index = (uint32_t)goal;
+    for (int i = length; i >= 0; i--) {
+        path[i] = &ps->nodes.boards[index * ps->shape.words];
+        index = ps->nodes.parents[index];
+    }
+
+    unsigned char from[SOLVER_MAX_MOVES], to[SOLVER_MAX_MOVES];
+    if (!packTracePath(&ps->shape, start, path, length, from, to)) return false;
+    for (int i = 0; i < length; i++) {
+        result->moves[i].from = from[i];
+        result->moves[i].to = to[i];
+    }
+    result->numMoves = length;
+    return true;
+}
+
+// Une passe complète avec la borne courante : 1 = résolu, 0 = borne trop basse, -1 = échec
+static int searchWithBound(ParallelSearch *ps, const uint64_t *rootKey, const PileCode *start, SolverResult *result) {
+    sttClear(&ps->table);
+    sttInsert(&ps->table, rootKey, packHash(rootKey, ps->shape.words));
+    ps->nodes.count = 0;
+    appendNode(&ps->nodes, ps->shape.words, rootKey, UINT32_MAX);
+    atomic_store(&ps->stored, 1);
+
+    size_t layerBegin = 0;
+    for (ps->depth = 0; ps->depth < ps->bound; ps->depth++) {
+        size_t layerEnd = ps->nodes.count;
+        if (layerBegin == layerEnd) return 0;
+        splitLayer(ps, layerBegin, layerEnd);
+
+        pthread_barrier_wait(&ps->barrier);
+        expandLayer(&ps->workers[0]);
+        pthread_barrier_wait(&ps->barrier);
+        long goal = prepareMerge(ps);
+        pthread_barrier_wait(&ps->barrier);
+        copyLayerOut(&ps->workers[0]);
+        pthread_barrier_wait(&ps->barrier);
+
+        if (goal >= 0) {
+            return buildSolution(ps, goal, start, result) ? 1 : -1;
+        }
+        if (atomic_load(&ps->failed)) return -1;
+        layerBegin = layerEnd;
+    }
+    return 0;
+}
+
+bool solveGameParallel(const GameState *game, int numThreads, size_t maxNodes, SolverResult *result) {
+    memset(result, 0, sizeof(*result));
+    if (maxNodes == 0) maxNodes = SOLVER_DEFAULT_MAX_NODES;
+    if (numThreads <= 0) numThreads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (numThreads < 1) numThreads = 1;
+    if (numThreads > MAX_THREADS) numThreads = MAX_THREADS;
+
+    ParallelSearch ps;
+    memset(&ps, 0, sizeof(ps));
+    if (!packShapeInit(&ps.shape, game)) return false;
+
+    PileCode start[MAX_PILES];
+    packFromGame(&ps.shape, game, start);
+    ps.bound = packHeuristic(&ps.shape, start);
+    if (ps.bound == 0) {
+        result->solved = true;
+        return true;
+    }
+
+    uint64_t rootKey[PACK_MAX_WORDS];
+    packCanonical(&ps.shape, start, rootKey, NULL);
+
+    ps.maxNodes = maxNodes;
+    ps.numThreads = numThreads;
+    ps.workers = calloc(numThreads, sizeof(Worker));
+    ps.ranges = aligned_alloc(64, numThreads * sizeof(WorkRange));
+    if (!ps.workers || !ps.ranges || !sttInit(&ps.table, ps.shape.words, maxNodes * 2)) {
+        free(ps.workers);
+        free(ps.ranges);
+        return false;
+    }
+    for (int t = 0; t < numThreads; t++) {
+        ps.workers[t].search = &ps;
+        ps.workers[t].id = t;
+        ps.workers[t].goal = -1;
+    }
+    // Le thread appelant joue le rôle du worker 0 et coordonne les couches ; la barrière
+    // n'est créée qu'une fois connu le nombre de threads réellement lancés
+    int started = 1;
+    while (started < numThreads &&
+           pthread_create(&ps.workers[started].thread, NULL, workerMain, &ps.workers[started]) == 0) {
+        started++;
+    }
+    ps.numThreads = started;
+    pthread_barrier_init(&ps.barrier, NULL, started);
+    atomic_store(&ps.ready, true);
+
+    while (ps.bound <= SOLVER_MAX_MOVES) {
+        for (int t = 0; t < started; t++) {
+            ps.workers[t].nextBound = INT_MAX;
+        }
+        int status = searchWithBound(&ps, rootKey, start, result);
+        if (status != 0) {
+            result->solved = status > 0;
+            break;
+        }
+        // Comme IDA* : sauter directement à la plus petite valeur f élaguée
+        int nextBound = INT_MAX;
+        for (int t = 0; t < started; t++) {
+            if (ps.workers[t].nextBound < nextBound) nextBound = ps.workers[t].nextBound;
+        }
+        if (nextBound == INT_MAX) break;   // Aucun état élagué : plateau insoluble
+        ps.bound = nextBound;
+        atomic_store(&ps.stop, false);
+    }
+
+    result->nodesStored = ps.nodes.count;
+    ps.done = true;
+    pthread_barrier_wait(&ps.barrier);
+    for (int t = 1; t < started; t++) {
+        pthread_join(ps.workers[t].thread, NULL);
+    }
+    for (int t = 0; t < numThreads; t++) {
+        result->nodesExpanded += ps.workers[t].expanded;
+        freeNodes(&ps.workers[t].out);
+    }
+
+    pthread_barrier_destroy(&ps.barrier);
+    freeNodes(&ps.nodes);
+    sttFree(&ps.table);
+    free(ps.workers);
+    free(ps.ranges);
+    return result->solved;
+}
@@ -0,0 +1,324 @@
+#include "textcache.h"
+#include "batch.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#define NUM_BUCKETS (TEXT_CACHE_MAX_ENTRIES * 2)
+#define NONE -1
+
+typedef struct {
+    TTF_Font *font;
+    Uint32 color;
+    char text[TEXT_CACHE_MAX_LENGTH + 1];
+    SDL_Texture *texture;
+    int w;
+    int h;
+    int nextInBucket;
+    int prev;           // Liste LRU : prev = plus récent
+    int next;
+    unsigned drawId;    // Dernier textCacheDraw qui l'a utilisée
+} TextEntry;
+
+static struct {
+    TextEntry entries[TEXT_CACHE_MAX_ENTRIES];
+    int buckets[NUM_BUCKETS];
+    int numEntries;
+    int freeSlots[TEXT_CACHE_MAX_ENTRIES];
+    int numFree;
+    int mostRecent;
+    int leastRecent;
+    size_t bytes;
+    unsigned drawId;    // textCacheDraw en cours : ses morceaux ne sont pas évincés
+} cache;
+
+// Atlas de glyphes chargé dans une texture blanche au premier texte qui l'utilise
+static struct {
+    const GlyphAtlas *source;
+    SDL_Renderer *renderer;     // Propriétaire de texture
+    SDL_Texture *texture;
+    SpriteBatch batch;
+} glyphs;
+
+void textFontInit(TextFont *font, const GlyphAtlas *atlas, const char *path, int size, GlyphStyle style) {
+    memset(font, 0, sizeof(*font));
+    font->path = path;
+    font->size = size;
+    font->atlas = atlas;
+    font->glyphs = glyphAtlasFont(atlas, style, size);
+}
+
+void textFontClose(TextFont *font) {
+    if (font->ttf) TTF_CloseFont(font->ttf);
+    font->ttf = NULL;
+}
+
+static TTF_Font *openTtf(TextFont *font) {
+    if (!font->ttf && !font->ttfFailed) {
+        font->ttf = TTF_OpenFont(font->path, font->size);
+        if (!font->ttf) {
+            printf("Erreur de chargement de la police %s: %s\n", font->path, TTF_GetError());
+            font->ttfFailed = true;
+        }
+    }
+    return font->ttf;
+}
+
+static Uint32 packColor(SDL_Color color) {
+    return (Uint32)color.r << 24 | (Uint32)color.g << 16 | (Uint32)color.b << 8 | color.a;
+}
+
+static unsigned hashKey(TTF_Font *font, const char *text, size_t length, Uint32 color) {
+    // FNV-1a
+    uint32_t h = 2166136261u ^ (uint32_t)(uintptr_t)font ^ color;
+    for (size_t i = 0; i < length; i++) {
+        h = (h ^ (unsigned char)text[i]) * 16777619u;
+    }
+    return h % NUM_BUCKETS;
+}
+
+static void unlinkLru(int index) {
+    TextEntry *entry = &cache.entries[index];
+    if (entry->prev != NONE) cache.entries[entry->prev].next = entry->next;
+    else cache.mostRecent = entry->next;
+    if (entry->next != NONE) cache.entries[entry->next].prev = entry->prev;
+    else cache.leastRecent = entry->prev;
+}
+
+static void pushFrontLru(int index) {
+    TextEntry *entry = &cache.entries[index];
+    entry->prev = NONE;
+    entry->next = cache.mostRecent;
+    if (cache.mostRecent != NONE) cache.entries[cache.mostRecent].prev = index;
+    cache.mostRecent = index;
+    if (cache.leastRecent == NONE) cache.leastRecent = index;
+}
+
+static void removeFromBucket(int index) {
+    TextEntry *entry = &cache.entries[index];
+    int *link = &cache.buckets[hashKey(entry->font, entry->text, strlen(entry->text), entry->color)];
+    while (*link != index) link = &cache.entries[*link].nextInBucket;
+    *link = entry->nextInBucket;
+}
+
+// Entrée la moins récemment utilisée hors du dessin en cours, ou NONE
+static int leastRecentUnpinned(void) {
+    int index = cache.leastRecent;
+    while (index != NONE && cache.entries[index].drawId == cache.drawId) {
+        index = cache.entries[index].prev;
+    }
+    return index;
+}
+
+// Libère l'entrée et retourne son indice
+static int evict(int index) {
+    TextEntry *entry = &cache.entries[index];
+    unlinkLru(index);
+    removeFromBucket(index);
+    cache.bytes -= (size_t)entry->w * entry->h * 4;
+    SDL_DestroyTexture(entry->texture);
+    entry->texture = NULL;
+    return index;
+}
+
+void textCacheInit(void) {
+    memset(&cache, 0, sizeof(cache));
+    cache.mostRecent = NONE;
+    cache.leastRecent = NONE;
+    for (int i = 0; i < NUM_BUCKETS; i++) {
+        cache.buckets[i] = NONE;
+    }
+}
+
+void textCacheFlush(void) {
+    for (int i = 0; i < cache.numEntries; i++) {
+        if (cache.entries[i].texture) SDL_DestroyTexture(cache.entries[i].texture);
+    }
+    textCacheInit();
+    if (glyphs.texture) SDL_DestroyTexture(glyphs.texture);
+    glyphs.texture = NULL;
+    glyphs.source = NULL;
+    glyphs.renderer = NULL;
+}
+
+void textCacheShutdown(void) {
+    textCacheFlush();
+    batchFree(&glyphs.batch);
+    memset(&glyphs, 0, sizeof(glyphs));
+}
+
+// Texture de l'atlas : blanc partout, l'opacité vient du fichier ; la couleur est une teinte
+static SDL_Texture *glyphTexture(SDL_Renderer *renderer, const GlyphAtlas *atlas) {
+    if (glyphs.source == atlas && glyphs.renderer == renderer) return glyphs.texture;
+    if (glyphs.texture) SDL_DestroyTexture(glyphs.texture);
+    glyphs.source = atlas;
+    glyphs.renderer = renderer;
+    glyphs.texture = NULL;
+
+    int w = (int)atlas->header->width, h = (int)atlas->header->height;
+    SDL_Surface *surface = SDL_CreateRGBSurfaceWithFormat(0, w, h, 32, SDL_PIXELFORMAT_RGBA32);
+    if (!surface) {
+        printf("Erreur de création de l'atlas de glyphes: %s\n", SDL_GetError());
+        return NULL;
+    }
+    for (int y = 0; y < h; y++) {
+        uint8_t *row = (uint8_t *)surface->pixels + y * surface->pitch;
+        for (int x = 0; x < w; x++) {
+            row[x * 4] = row[x * 4 + 1] = row[x * 4 + 2] = 255;
+            row[x * 4 + 3] = atlas->pixels[y * w + x];
+        }
+    }
+    glyphs.texture = SDL_CreateTextureFromSurface(renderer, surface);
+    SDL_FreeSurface(surface);
+    if (!glyphs.texture) {
+        printf("Erreur de création de texture: %s\n", SDL_GetError());
+        return NULL;
+    }
+    SDL_SetTextureBlendMode(glyphs.texture, SDL_BLENDMODE_BLEND);
+    return glyphs.texture;
+}
+
+// Texte en un seul lot depuis l'atlas (sans crénage) ; les caractères absents sont sautés
+static void drawFromAtlas(SDL_Renderer *renderer, TextFont *font, const char *text, int x, int y,
+                          SDL_Color color, bool centered) {
+    SDL_Texture *texture = glyphTexture(renderer, font->atlas);
+    if (!texture) return;
+
+    int width;
+    glyphFontMeasure(font->glyphs, text, &width);
+    if (centered) {
+        x -= width / 2;
+        y -= font->glyphs->height / 2;
+    }
+
+    batchBegin(&glyphs.batch, texture);
+    batchTint(&glyphs.batch, color);
+    for (const unsigned char *c = (const unsigned char *)text; *c; c++) {
+        const GlyphMetrics *glyph = glyphFontGlyph(font->glyphs, *c);
+        if (!glyph) continue;
+        if (glyph->w > 0) {
+            SDL_Rect src = {glyph->x, glyph->y, glyph->w, glyph->h};
+            SDL_Rect dst = {x + glyph->offsetX, y + glyph->offsetY, glyph->w, glyph->h};
+            if (!batchQuad(&glyphs.batch, &src, &dst)) {
+                // Lot plein faute de mémoire : dessiner ce qu'il contient et continuer
+                batchFlush(&glyphs.batch, renderer);
+                batchQuad(&glyphs.batch, &src, &dst);
+            }
+        }
+        x += glyph->advance;
+    }
+    batchFlush(&glyphs.batch, renderer);
+}
+
+// Texture d'un morceau de texte (length caractères), rastérisée au premier usage
+static TextEntry *lookup(SDL_Renderer *renderer, TTF_Font *font, const char *text, size_t length, SDL_Color color) {
+    Uint32 packed = packColor(color);
+    unsigned bucket = hashKey(font, text, length, packed);
+    for (int i = cache.buckets[bucket]; i != NONE; i = cache.entries[i].nextInBucket) {
+        TextEntry *entry = &cache.entries[i];
+        if (entry->font == font && entry->color == packed &&
+            strncmp(entry->text, text, length) == 0 && entry->text[length] == '\0') {
+            unlinkLru(i);
+            pushFrontLru(i);
+            entry->drawId = cache.drawId;
+            return entry;
+        }
+    }
+
+    char key[TEXT_CACHE_MAX_LENGTH + 1];
+    memcpy(key, text, length);
+    key[length] = '\0';
+
+    SDL_Surface *surface = TTF_RenderText_Blended(font, key, color);
+    if (!surface) {
+        printf("Erreur de rendu du texte: %s\n", TTF_GetError());
+        return NULL;
+    }
+    SDL_Texture *texture = SDL_CreateTextureFromSurface(renderer, surface);
+    int w = surface->w, h = surface->h;
+    SDL_FreeSurface(surface);
+    if (!texture) {
+        printf("Erreur de création de texture: %s\n", SDL_GetError());
+        return NULL;
+    }
+
+    // Limite en octets : libérer les entrées les plus anciennes, leurs emplacements sont réutilisés.
+    // Les morceaux déjà pris par le dessin en cours restent, quitte à dépasser la limite.
+    size_t bytes = (size_t)w * h * 4;
+    int victim;
+    while (cache.bytes + bytes > TEXT_CACHE_MAX_BYTES && (victim = leastRecentUnpinned()) != NONE) {
+        cache.freeSlots[cache.numFree++] = evict(victim);
+    }
+
+    int index;
+    if (cache.numFree > 0) {
+        index = cache.freeSlots[--cache.numFree];
+    } else if (cache.numEntries < TEXT_CACHE_MAX_ENTRIES) {
+        index = cache.numEntries++;
+    } else {
+        // Un dessin garde au plus TEXT_CACHE_MAX_LENGTH * 2 morceaux, moins que TEXT_CACHE_MAX_ENTRIES
+        index = evict(leastRecentUnpinned());
+    }
+
+    TextEntry *entry = &cache.entries[index];
+    entry->font = font;
+    entry->color = packed;
+    memcpy(entry->text, key, length + 1);
+    entry->texture = texture;
+    entry->w = w;
+    entry->h = h;
+    entry->drawId = cache.drawId;
+    entry->nextInBucket = cache.buckets[bucket];
+    cache.buckets[bucket] = index;
+    pushFrontLru(index);
+    cache.bytes += bytes;
+    return entry;
+}
+
+// Découpe le texte en morceaux : chaque chiffre seul, le reste par plages
+static size_t segmentLength(const char *text) {
+    if (text[0] >= '0' && text[0] <= '9') return 1;
+    size_t length = 0;
+    while (text[length] && !(text[length] >= '0' && text[length] <= '9') && length < TEXT_CACHE_MAX_LENGTH) {
+        length++;
+    }
+    return length;
+}
+
+void textCacheDraw(SDL_Renderer *renderer, TextFont *textFont, const char *text, int x, int y, SDL_Color color, bool centered) {
+    if (!text[0]) return;
+
+    // L'atlas d'abord ; la police n'est ouverte que s'il lui manque un caractère, et s'il n'y
+    // a pas de police l'atlas dessine ce qu'il a
+    int atlasWidth;
+    bool complete = textFont->glyphs && glyphFontMeasure(textFont->glyphs, text, &atlasWidth);
+    TTF_Font *font = complete ? NULL : openTtf(textFont);
+    if (!font) {
+        if (textFont->glyphs) drawFromAtlas(renderer, textFont, text, x, y, color, centered);
+        return;
+    }
+
+    // Première passe : mesurer (et mettre en cache) les morceaux, gardés jusqu'au dessin
+    cache.drawId++;
+    TextEntry *segments[TEXT_CACHE_MAX_LENGTH * 2];
+    int numSegments = 0, width = 0, height = 0;
+    for (const char *p = text; *p && numSegments < (int)SDL_arraysize(segments); ) {
+        size_t length = segmentLength(p);
+        TextEntry *entry = lookup(renderer, font, p, length, color);
+        p += length;
+        if (!entry) continue;
+        segments[numSegments++] = entry;
+        width += entry->w;
+        if (entry->h > height) height = entry->h;
+    }
+
+    if (centered) {
+        x -= width / 2;
+        y -= height / 2;
+    }
+    for (int i = 0; i < numSegments; i++) {
+        SDL_Rect dst = {x, y, segments[i]->w, segments[i]->h};
+        SDL_RenderCopy(renderer, segments[i]->texture, NULL, &dst);
+        x += segments[i]->w;
+    }
+}
@@ -0,0 +1,44 @@
+#ifndef TEXTCACHE_H
+#define TEXTCACHE_H
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <stdbool.h>
+#include "glyphatlas.h"
+
+// Cache de textures de texte indexé par (police, chaîne, couleur), avec éviction LRU
+// bornée en nombre d'entrées et en octets de texture
+#define TEXT_CACHE_MAX_ENTRIES 256
+#define TEXT_CACHE_MAX_BYTES (8 * 1024 * 1024)
+#define TEXT_CACHE_MAX_LENGTH 63
+
+// Police de l'interface : les glyphes pré-rendus de l'atlas s'il contient tous les caractères
+// du texte, sinon SDL_ttf, dont le fichier n'est ouvert qu'au premier texte qui en a besoin
+typedef struct {
+    const char *path;
+    int size;
+    const GlyphAtlas *atlas;
+    const GlyphFont *glyphs;    // NULL si l'atlas n'a pas cette police
+    TTF_Font *ttf;
+    bool ttfFailed;             // Ouverture déjà tentée sans succès
+} TextFont;
+
+// atlas peut être NULL (pas de fichier d'atlas) ; rien n'est ouvert ici
+void textFontInit(TextFont *font, const GlyphAtlas *atlas, const char *path, int size, GlyphStyle style);
+void textFontClose(TextFont *font);
+
+// Toutes les textures appartiennent au renderer passé à textCacheDraw (un seul renderer)
+void textCacheInit(void);
+void textCacheShutdown(void);
+
+// Détruit toutes les textures (textes et atlas de glyphes), qui seront recréées à la demande
+// (perte du périphérique de rendu)
+void textCacheFlush(void);
+
+// Dessine le texte en (x, y) (coin haut-gauche, ou centre si centered). Depuis l'atlas, le texte
+// est un lot de quadrilatères teintés. Avec SDL_ttf, les chiffres sont mis en cache un par un :
+// les compteurs (coups, chrono) ne sont jamais re-rastérisés. Sans police ni atlas, les
+// caractères manquants ne sont pas dessinés.
+void textCacheDraw(SDL_Renderer *renderer, TextFont *font, const char *text, int x, int y, SDL_Color color, bool centered);
+
+#endif
@@ -0,0 +1,141 @@
+#include "transtable.h"
+#include "boardpack.h"
+#include <stdlib.h>
+#include <string.h>
+
+static bool ttAlloc(TransTable *tt, size_t capacity) {
+    tt->keys = malloc(capacity * tt->words * sizeof(uint64_t));
+    tt->values = malloc(capacity * sizeof(uint32_t));
+    if (!tt->keys || !tt->values) {
+        free(tt->keys);
+        free(tt->values);
+        return false;
+    }
+    memset(tt->values, 0xff, capacity * sizeof(uint32_t));
+    tt->mask = capacity - 1;
+    return true;
+}
+
+bool ttInit(TransTable *tt, int words, size_t capacity) {
+    size_t size = 1024;
+    while (size < capacity) size *= 2;
+    tt->words = words;
+    tt->count = 0;
+    return ttAlloc(tt, size);
+}
+
+void ttFree(TransTable *tt) {
+    free(tt->keys);
+    free(tt->values);
+    tt->keys = NULL;
+    tt->values = NULL;
+}
+
+static size_t ttProbe(const TransTable *tt, const uint64_t *key, uint64_t hash) {
+    size_t slot = hash & tt->mask;
+    size_t bytes = tt->words * sizeof(uint64_t);
+    while (tt->values[slot] != TT_EMPTY &&
+           memcmp(&tt->keys[slot * tt->words], key, bytes) != 0) {
+        slot = (slot + 1) & tt->mask;
+    }
+    return slot;
+}
+
+uint32_t *ttLookup(TransTable *tt, const uint64_t *key, uint64_t hash) {
+    size_t slot = ttProbe(tt, key, hash);
+    return tt->values[slot] != TT_EMPTY ? &tt->values[slot] : NULL;
+}
+
+// Doubler la capacité (facteur de charge maximal 1/2)
+static bool ttGrow(TransTable *tt) {
+    TransTable old = *tt;
+    if (!ttAlloc(tt, (old.mask + 1) * 2)) {
+        *tt = old;
+        return false;
+    }
+    for (size_t i = 0; i <= old.mask; i++) {
+        if (old.values[i] == TT_EMPTY) continue;
+        const uint64_t *key = &old.keys[i * old.words];
+        size_t slot = ttProbe(tt, key, packHash(key, old.words));
+        memcpy(&tt->keys[slot * tt->words], key, tt->words * sizeof(uint64_t));
+        tt->values[slot] = old.values[i];
+    }
+    free(old.keys);
+    free(old.values);
+    return true;
+}
+
+uint32_t *ttInsert(TransTable *tt, const uint64_t *key, uint64_t hash, bool *found) {
+    if ((tt->count + 1) * 2 > tt->mask + 1 && !ttGrow(tt)) return NULL;
+
+    size_t slot = ttProbe(tt, key, hash);
+    *found = tt->values[slot] != TT_EMPTY;
+    if (!*found) {
+        memcpy(&tt->keys[slot * tt->words], key, tt->words * sizeof(uint64_t));
+        tt->count++;
+    }
+    return &tt->values[slot];
+}
+
+#define STT_BUSY ((uint64_t)1 << 8)   // Époque 0 : emplacement en cours d'écriture
+
+bool sttInit(SharedTransTable *tt, int words, size_t capacity) {
+    size_t size = 1024;
+    while (size < capacity) size *= 2;
+    // calloc : les pages ne sont réellement allouées qu'au premier accès
+    tt->tags = calloc(size, sizeof(*tt->tags));
+    tt->keys = malloc(size * words * sizeof(uint64_t));
+    if (!tt->tags || !tt->keys) {
+        free((void *)tt->tags);
+        free(tt->keys);
+        return false;
+    }
+    tt->mask = size - 1;
+    tt->words = words;
+    tt->epoch = 1;
+    return true;
+}
+
+void sttFree(SharedTransTable *tt) {
+    free((void *)tt->tags);
+    free(tt->keys);
+    tt->tags = NULL;
+    tt->keys = NULL;
+}
+
+void sttClear(SharedTransTable *tt) {
+    if (++tt->epoch > 0xff) {
+        memset((void *)tt->tags, 0, (tt->mask + 1) * sizeof(*tt->tags));
+        tt->epoch = 1;
+    }
+}
+
+SharedInsertResult sttInsert(SharedTransTable *tt, const uint64_t *key, uint64_t hash) {
+    uint64_t tag = (hash << 8) | tt->epoch;
+    size_t bytes = tt->words * sizeof(uint64_t);
+    size_t slot = hash & tt->mask;
+
+    for (size_t probes = 0; probes <= tt->mask; probes++) {
+        uint64_t current = atomic_load_explicit(&tt->tags[slot], memory_order_acquire);
+
+        // Emplacement libre (jamais utilisé ou d'une époque précédente) : le réserver
+        while (current != STT_BUSY && (current & 0xff) != tt->epoch) {
+            if (atomic_compare_exchange_weak_explicit(&tt->tags[slot], &current, STT_BUSY,
+                                                      memory_order_acquire, memory_order_acquire)) {
+                memcpy(&tt->keys[slot * tt->words], key, bytes);
+                atomic_store_explicit(&tt->tags[slot], tag, memory_order_release);
+                return STT_INSERTED;
+            }
+        }
+
+        // Attendre la publication d'une clé en cours d'écriture
+        while (current == STT_BUSY) {
+            current = atomic_load_explicit(&tt->tags[slot], memory_order_acquire);
+        }
+        if (current == tag && memcmp(&tt->keys[slot * tt->words], key, bytes) == 0) {
+            return STT_FOUND;
+        }
+        slot = (slot + 1) & tt->mask;
+    }
+    return STT_FULL;
+}
@@ -0,0 +1,53 @@
+#ifndef TRANSTABLE_H
+#define TRANSTABLE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdatomic.h>
+
+#define TT_EMPTY UINT32_MAX
+
+// Table de transposition à adressage ouvert (sondage linéaire) indexée par
+// un plateau compact de `words` mots ; chaque clé porte une valeur sur 32 bits.
+typedef struct {
+    uint64_t *keys;
+    uint32_t *values;   // TT_EMPTY = emplacement libre
+    size_t mask;
+    size_t count;
+    int words;
+} TransTable;
+
+bool ttInit(TransTable *tt, int words, size_t capacity);
+void ttFree(TransTable *tt);
+
+// Pointeur vers la valeur associée à la clé, ou NULL si absente
+uint32_t *ttLookup(TransTable *tt, const uint64_t *key, uint64_t hash);
+
+// Insère la clé si besoin (*found indique si elle existait déjà) ; l'appelant doit
+// alors écrire la valeur. hash doit valoir packHash(key, words). NULL si la mémoire manque.
+uint32_t *ttInsert(TransTable *tt, const uint64_t *key, uint64_t hash, bool *found);
+
+// Variante partagée entre threads, sans verrou et de capacité fixe : chaque emplacement
+// est réservé par CAS sur son étiquette puis publié une fois la clé écrite. Une époque
+// stockée dans l'étiquette permet de vider la table en O(1) entre deux passes.
+typedef struct {
+    _Atomic uint64_t *tags;   // (hash << 8) | époque, 0 = jamais utilisé
+    uint64_t *keys;
+    size_t mask;
+    int words;
+    uint64_t epoch;           // 1..255
+} SharedTransTable;
+
+typedef enum {
+    STT_INSERTED,
+    STT_FOUND,
+    STT_FULL
+} SharedInsertResult;
+
+bool sttInit(SharedTransTable *tt, int words, size_t capacity);
+void sttFree(SharedTransTable *tt);
+void sttClear(SharedTransTable *tt);   // À appeler sans insertion concurrente
+SharedInsertResult sttInsert(SharedTransTable *tt, const uint64_t *key, uint64_t hash);
+
+#endif